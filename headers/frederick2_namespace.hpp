@@ -12,7 +12,9 @@
 
 #include <functional>
 #include <map>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -24,10 +26,17 @@ namespace frederick2
     namespace httpEnums
     {
         class converter;
+        enum class contentCoding;
+        enum class h2ErrorCode;
+        enum class h2FrameType;
         enum class httpHeader;
         enum class httpMethod;
         enum class httpProtocol;
         enum class httpStatus;
+        enum class latencyStage;
+        enum class logField;
+        enum class metricType;
+        enum class paramType;
         enum class resourceType;
         enum class uriHostType;
         enum class uriScheme;
@@ -45,17 +54,36 @@ namespace frederick2
 
     namespace httpServer
     {
+        class accessLog;
         class connection;
+        class handshakePool;
+        class http2Session;
         class httpServer;
+        class memoryGovernor;
+        class metricsRegistry;
+        class middlewareChain;
         class resource;
+        class responseCache;
+        class routeRegistry;
+        class routeTable;
         class socket;
+        class streamPool;
+        class testHarness;
+        class ticketKeys;
         class uri;           
     }
 
     namespace utility
     {
         class bufferStringReader;
+        class compressor;
+        class cycleClock;
+        class headerCache;
+        class headerList;
+        class hpack;
         class parseUtilities;
+        class requestArena;
+        class viewLess;
     }
 }
 
@@ -64,9 +92,11 @@ namespace frederick2
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 typedef std::function<void(frederick2::httpPacket::httpRequest*, frederick2::httpPacket::httpResponse*)> httpHandler;
+typedef std::function<void(frederick2::httpPacket::httpRequest*, frederick2::httpPacket::httpResponse*, frederick2::httpServer::middlewareChain&)> httpMiddleware;
 typedef std::map<frederick2::httpEnums::httpMethod, httpHandler> methodMAPhandler;
 typedef std::map<frederick2::httpEnums::httpMethod, std::string> methodMAPstr;
 typedef std::map<frederick2::httpEnums::httpProtocol, std::string> protocolMAPstr;
+typedef std::pmr::map<std::pmr::string, std::pmr::string, frederick2::utility::viewLess> pmrMAPstr;
 typedef std::map<frederick2::httpEnums::httpStatus, std::string> statusMAPstr;
 typedef std::map<std::string, frederick2::httpEnums::httpMethod> strMAPmethod;
 typedef std::map<std::string, frederick2::httpEnums::httpProtocol> strMAPprotocol;
@@ -74,6 +104,8 @@ typedef std::map<std::string, frederick2::httpServer::resource*> strMAPresource;
 typedef std::map<std::string, frederick2::httpEnums::uriScheme> strMAPscheme;
 typedef std::map<std::string, std::string> strMAPstr;
 typedef std::pair<bool, httpHandler> handlerCheck;
+typedef std::vector<std::pair<std::string, std::string>> strPairVECTOR;
 typedef std::vector<std::string> strVECTOR;
+typedef std::pmr::vector<std::pair<std::string_view, std::string_view>> viewPairVECTOR;
 
 #endif
\ No newline at end of file
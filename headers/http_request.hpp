@@ -10,32 +10,49 @@
 #ifndef HTTP_REQUEST_HPP
 #define HTTP_REQUEST_HPP
 
+#include <array>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "frederick2_namespace.hpp"
 #include "server.hpp"
+#include "server_access_log.hpp"
 #include "server_connection.hpp"
 #include "server_uri.hpp"
+#include "utility_arena.hpp"
 
 class frederick2::httpPacket::httpRequest
 {
 public:
     std::string getContent();
+    std::string_view getContentView() const;
+    const pmrMAPstr& getCookieMap() const;
     strMAPstr getCookies();
     std::string getFilePath();
     std::string getHeader(const std::string&);    
+    const pmrMAPstr& getHeaderMap() const;
     strMAPstr getHeaders();
+    std::string_view getHeaderView(std::string_view) const;
     int getMajorVersion();
     frederick2::httpEnums::httpMethod getMethod();
     int getMinorVersion();
+    bool getPathChoice(const std::string&, size_t&);
+    bool getPathHex(const std::string&, uint64_t&);
+    bool getPathInt(const std::string&, int64_t&);
     std::string getPathParameter(const std::string&);
+    bool getPathUUID(const std::string&, std::array<uint8_t, 16>&);
     frederick2::httpEnums::httpProtocol getProtocol();
     std::string getQueryParameter(const std::string&);
     frederick2::httpEnums::httpStatus getStatus();
     std::string getStatusReason();
+    const frederick2::httpServer::uri& getURI() const;
     bool getHasContent();
+    std::string takeContent();
     ~httpRequest();
 protected:
 private:
@@ -43,22 +60,49 @@ private:
     // Friend Declarations
     ///////////////////////////////////////////////////////////////////////////////
     friend class frederick2::httpServer::connection;
+    friend class frederick2::httpServer::http2Session;
     friend class frederick2::httpServer::httpServer;
+    friend class frederick2::httpServer::routeTable;
+    friend class frederick2::httpServer::testHarness;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    struct pathValue
+    {
+        std::string_view name;
+        frederick2::httpEnums::paramType type;
+        int64_t number;
+        uint64_t bits;
+        std::array<uint8_t, 16> uuid;
+    };
+    struct stageClock
+    {
+        uint64_t firstByte;
+        uint64_t headersDone;
+        uint64_t bodyDone;
+        uint64_t handlerStart;
+        uint64_t handlerEnd;
+    };
+    static constexpr size_t pathValueCapacity{4};
+    static constexpr size_t stageCount{static_cast<size_t>(frederick2::httpEnums::latencyStage::TOTAL) + 1};
     ///////////////////////////////////////////////////////////////////////////////
     // Private Functions
     ///////////////////////////////////////////////////////////////////////////////
     explicit httpRequest(std::string*);
     void addFileSegment(const std::string&);
     void addHeader(const std::string&, const std::string&);
-    void addPathParameter(const std::string&, const std::string&);
+    void addPathParameter(std::string_view, std::string_view);
     bool buildRequest();
     frederick2::httpEnums::httpStatus collectRequestBody();
-    frederick2::httpServer::uri getURI();
+    const pathValue *findPathValue(const std::string&, frederick2::httpEnums::paramType) const;
+    void recycle();
+    void reset(std::string*);
     void setMethod(frederick2::httpEnums::httpMethod);
     frederick2::httpEnums::httpStatus validateRequest();
     ///////////////////////////////////////////////////////////////////////////////
     // Private Properties
     ///////////////////////////////////////////////////////////////////////////////
+    std::unique_ptr<frederick2::utility::requestArena> arena;
     std::string *buffer;
     std::string content;
     std::string filePath;
@@ -70,12 +114,17 @@ private:
     size_t contentReceived;
     size_t contentLength;
     size_t bytesReceived;
+    size_t pathValueCount;
     bool hasContent;
     bool contentChunked;
-    strMAPstr cookies;
-    strMAPstr headers;
-    strMAPstr pathParameters;
-    strMAPstr queryParameters;
+    pmrMAPstr cookies;
+    pmrMAPstr headers;
+    viewPairVECTOR pathParameters;
+    std::array<pathValue, pathValueCapacity> pathValues;
+    std::array<size_t, stageCount> stageSeries;
+    stageClock stages;
+    frederick2::httpServer::accessLog::logEntry logEntry;
+    frederick2::httpServer::memoryGovernor *memory;
     frederick2::httpServer::uri uriObj;
     frederick2::httpEnums::httpMethod method;
     frederick2::httpEnums::httpProtocol protocol;
@@ -10,9 +10,14 @@
 #ifndef HTTP_RESPONSE_HPP
 #define HTTP_RESPONSE_HPP
 
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "frederick2_namespace.hpp"
+#include "utility_header_list.hpp"
 
 class frederick2::httpPacket::httpResponse
 {
@@ -20,7 +25,9 @@ public:
     httpResponse();
     void addCookie(const std::string&, const std::string&);
     void addHeader(const std::string&, const std::string&);
+    void appendHeader(const std::string&, const std::string&);
     void setContent(const std::string&);
+    bool setContentFile(const std::string&);
     void setStatus(frederick2::httpEnums::httpStatus);
     void setStatusReason(const std::string&);
     ~httpResponse();
@@ -30,20 +37,36 @@ private:
     // Friend Declarations
     ///////////////////////////////////////////////////////////////////////////////
     friend class frederick2::httpServer::connection;
+    friend class frederick2::httpServer::http2Session;
     friend class frederick2::httpServer::httpServer;
+    friend class frederick2::httpServer::testHarness;
     ///////////////////////////////////////////////////////////////////////////////
     // Private Functions
     ///////////////////////////////////////////////////////////////////////////////
+    explicit httpResponse(std::pmr::memory_resource*);
+    void appendContentString(std::string&);
+    void appendHeaderLines(std::string&);
+    void appendStatusLine(std::string&);
+    void appendVary(const std::string&);
+    bool compressContent(strVECTOR&);
+    bool compressEligible(size_t);
+    bool getContentFile(int&, size_t&);
     bool getHasContent();
     std::string getHeader(const std::string&);
-    std::string getHeaderLines();
     frederick2::httpEnums::httpStatus getStatus();
-    std::string getStatusLine();
     void handleContent();
+    bool loadContentFile();
+    bool openContentFile();
+    void recycle();
+    void reset(std::pmr::memory_resource*);
+    void setCachedPayload(std::shared_ptr<const std::string>, size_t);
+    void setCompression(frederick2::httpEnums::contentCoding, size_t, const strVECTOR*);
     void setMajorVersion(int);
     void setMinorVersion(int);
     void setProtocol(frederick2::httpEnums::httpProtocol);
     void setRequestMethod(frederick2::httpEnums::httpMethod);
+    void setZeroCopy(bool);
+    std::string toCacheString(size_t&, const std::vector<std::string>&);
     std::string toString();
     ///////////////////////////////////////////////////////////////////////////////
     // Private Properties
@@ -51,14 +74,22 @@ private:
     int versionMajor;
     int versionMinor;
     int contentChunks;
+    int contentFileDescriptor;
     size_t contentLength;
+    size_t cachedHeadLength;
+    size_t compressThreshold;
     bool hasContent;
     bool contentChunked;
-    strMAPstr cookies;
-    strMAPstr headers;
-    strVECTOR chunks;
+    bool fromCache;
+    bool zeroCopy;
+    std::optional<std::pmr::vector<std::pmr::string>> chunks;
     std::string content;
+    std::string contentFilePath;
     std::string statusReason;
+    std::shared_ptr<const std::string> cachedPayload;
+    frederick2::utility::headerList headers;
+    const strVECTOR *compressTypes;
+    frederick2::httpEnums::contentCoding contentCoding;
     frederick2::httpEnums::httpMethod requestMethod;
     frederick2::httpEnums::httpProtocol protocol;
     frederick2::httpEnums::httpStatus status;
@@ -11,21 +11,23 @@
 #define PARSE_HEADER_HPP
 
 #include <map>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
 #include "frederick2_namespace.hpp"
 #include "server_enum.hpp"
 #include "server_uri.hpp"
+#include "utility_arena.hpp"
 
 class frederick2::httpPacket::headerParser
 {
 public:
-    explicit headerParser(std::string*);
+    explicit headerParser(std::string*, std::pmr::memory_resource*);
     frederick2::httpEnums::httpStatus execute();
     size_t getBytesReceived();
-    strMAPstr getCookies();
-    strMAPstr getHeaders();
+    pmrMAPstr getCookies();
+    pmrMAPstr getHeaders();
     int getMajorVersion();
     frederick2::httpEnums::httpMethod getMethod();
     int getMinorVersion();
@@ -52,8 +54,8 @@ private:
     std::string originalRequestLine;
     std::string originalURIString;
     std::string statusReason;
-    strMAPstr cookies;
-    strMAPstr headers;
+    pmrMAPstr cookies;
+    pmrMAPstr headers;
     frederick2::httpEnums::httpMethod method;
     frederick2::httpEnums::httpProtocol protocol;
     frederick2::httpServer::uri uriObj;    
@@ -22,9 +22,9 @@ public:
     explicit headerLineParser(std::string*);
     frederick2::httpEnums::httpStatus execute();
     size_t getBytesReceived();
-    std::string getFieldName();
-    std::string getFieldValueString();
-    std::string getHeaderLineString();
+    const std::string& getFieldName();
+    const std::string& getFieldValueString();
+    const std::string& getHeaderLineString();
     std::string getStatusReason();
     ~headerLineParser();
 protected:
@@ -10,12 +10,19 @@
 #ifndef SERVER_HPP
 #define SERVER_HPP
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <future>
+#include <memory_resource>
+#include <mutex>
 #include <openssl/ssl.h>
 #include <string>
+#include <sys/socket.h>
 #include <vector>
 
 #include "frederick2_namespace.hpp"
+#include "server_enum.hpp"
 #include "http_request.hpp"
 #include "http_response.hpp"
 #include "server_connection.hpp"
@@ -26,17 +33,43 @@ public:
     explicit httpServer();
     httpServer(const httpServer&) = delete;
     httpServer& operator= (const httpServer&) = delete;
+    void addCompressionType(const std::string&);
+    size_t getAccessLogDropped();
+    size_t getHandshakeQueueDepth();
+    size_t getHandshakeQueuePeak();
+    size_t getHandshakesRejected();
+    size_t getMemoryUsage();
+    frederick2::httpServer::metricsRegistry* getMetrics();
     frederick2::httpServer::resource* getResourceTree();
+    double getStageLatency(const std::string&, frederick2::httpEnums::latencyStage, double);
+    size_t getTLSHandshakes();
+    size_t getTLSResumptions();
     bool runServer(std::future<void>);
+    void serveMetrics(frederick2::httpServer::resource*);
+    void setAccessLog(const std::string&);
+    void setAccessLogFormat(const std::string&);
+    void setAccessLogRotation(size_t, size_t);
     void setBindAddress(const std::string&);
     void setBindPort(int);
+    void setCacheSize(size_t);
+    void setCompression(bool);
+    void setCompressionThreshold(size_t);
     void setConnectionTimeout(size_t);
+    void setHandshakePool(size_t, size_t);
+    void setHandshakeTimeout(size_t);
     void setListenQueue(int);
+    void setMemoryLimits(size_t, size_t);
+    void setSessionCacheSize(size_t);
     void setSSLPrivateKey(const std::string&);
     void setSSLPublicCert(const std::string&);
+    void setStreamPool(size_t, size_t);
+    void setTicketRotation(size_t);
+    void setUseHTTP2(bool);
+    void setUseKTLS(bool);
     void setUseSSL(bool);
     bool start();
     void stop();
+    void updateRoutes(const std::function<void(frederick2::httpServer::resource*)>&);
     ~httpServer();
 protected:
 private:
@@ -44,13 +77,60 @@ private:
     // Friend Declarations
     ///////////////////////////////////////////////////////////////////////////////
     friend class frederick2::httpServer::connection;
+    friend class frederick2::httpServer::http2Session;
+    friend class frederick2::httpServer::middlewareChain;
+    friend class frederick2::httpServer::testHarness;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    struct dispatchState
+    {
+        frederick2::httpServer::resource *target{nullptr};
+        frederick2::httpEnums::httpMethod method{frederick2::httpEnums::httpMethod::ENUMERROR};
+        size_t cacheTTL{0};
+        std::string cacheKey{};
+        std::vector<std::string> outerHeaders{};
+        std::vector<std::string> innerHeaders{};
+    };
+    static constexpr size_t stageCount{static_cast<size_t>(frederick2::httpEnums::latencyStage::TOTAL) + 1};
+    struct builtinMetrics
+    {
+        size_t accepted;
+        size_t active;
+        size_t requests;
+        size_t bytesIn;
+        size_t bytesOut;
+        size_t parseErrors;
+        size_t requestTimeouts;
+        size_t idleTimeouts;
+        size_t stages;
+        std::array<size_t, stageCount> unroutedStages;
+        size_t accessLogDropped;
+    };
+    static constexpr size_t idleLimit{64};
     ///////////////////////////////////////////////////////////////////////////////
     // Private Functions
     ///////////////////////////////////////////////////////////////////////////////
+    frederick2::httpServer::connection *acquireConnection();
+    frederick2::httpPacket::httpRequest *acquireRequest(std::string*);
+    frederick2::httpPacket::httpResponse *acquireResponse(std::pmr::memory_resource*);
+    void appendCachePath(const std::string&, std::string&);
     void destroyOpenSSL();
-    frederick2::httpPacket::httpResponse *handleRequest(frederick2::httpPacket::httpRequest*);
+    void dispatchResource(frederick2::httpPacket::httpRequest*, frederick2::httpPacket::httpResponse*, dispatchState*);
+    bool fetchCachedResponse(frederick2::httpPacket::httpRequest*, frederick2::httpPacket::httpResponse*, frederick2::httpServer::resource*, std::string&);
+    frederick2::httpPacket::httpResponse *handleRequest(frederick2::httpPacket::httpRequest*, bool);
     void initializeOpenSSL();
-    frederick2::httpServer::resource *lookupResource(frederick2::httpPacket::httpRequest*);
+    void logAccess(frederick2::httpPacket::httpRequest*, const struct sockaddr*, size_t, uint64_t);
+    frederick2::httpServer::resource *lookupResource(const frederick2::httpServer::routeTable*, frederick2::httpPacket::httpRequest*);
+    void recordHandshake(bool);
+    void recordStages(frederick2::httpPacket::httpRequest*, uint64_t);
+    size_t prepareCachedResponse(frederick2::httpPacket::httpResponse*, frederick2::httpServer::resource*);
+    void prepareRoutes(frederick2::httpServer::routeTable*);
+    void releaseConnection(frederick2::httpServer::connection*);
+    void releaseRequest(frederick2::httpPacket::httpRequest*);
+    void releaseResponse(frederick2::httpPacket::httpResponse*);
+    bool serveConnection(frederick2::httpServer::connection*, std::future<void>);
+    frederick2::httpPacket::httpResponse *storeCachedResponse(frederick2::httpPacket::httpRequest*, frederick2::httpPacket::httpResponse*, const std::string&, size_t, const std::vector<std::string>&);
     ///////////////////////////////////////////////////////////////////////////////
     // Private Properties
     ///////////////////////////////////////////////////////////////////////////////
@@ -61,19 +141,52 @@ private:
     bool hasSSLCert;
     bool hasSSLKey;
     bool useSSL;
+    bool useHTTP2;
+    bool useKTLS;
+    bool useCompression;
     bool runningWithSSL;
     int bindPort;
     int listenQueue;
+    size_t accessLogBytes;
+    size_t accessLogKeep;
+    size_t cacheSize;
+    size_t compressionThreshold;
     size_t connectionTimeout;
+    size_t handshakeTimeout;
+    size_t handshakeThreads;
+    size_t handshakeQueue;
+    size_t sessionCacheSize;
+    size_t streamThreads;
+    size_t streamQueue;
+    size_t ticketRotation;
+    std::atomic<size_t> tlsHandshakes;
+    std::atomic<size_t> tlsResumptions;
     SSL_CTX *sslContext;
+    std::string accessLogFormat;
+    std::string accessLogPath;
     std::string strBindAddr;
     std::string sslCertPath;
     std::string sslKeyPath;
+    strVECTOR compressionTypes;
     std::future<bool> catchRunServer;
     std::promise<void> killRunServer;
+    std::mutex connectionLock;
+    std::vector<frederick2::httpServer::connection*> idleConnections;
+    std::mutex packetLock;
+    std::vector<frederick2::httpPacket::httpRequest*> idleRequests;
+    std::vector<frederick2::httpPacket::httpResponse*> idleResponses;
     std::vector<std::future<bool>> childFutures;
     std::vector<std::promise<void>> childPromises; 
     frederick2::httpServer::resource *rootResource;
+    frederick2::httpServer::responseCache *cache;
+    frederick2::httpServer::routeRegistry *routes;
+    frederick2::httpServer::handshakePool *cryptoPool;
+    frederick2::httpServer::streamPool *streamWorkers;
+    frederick2::httpServer::memoryGovernor *memory;
+    frederick2::httpServer::metricsRegistry *metrics;
+    frederick2::httpServer::accessLog *accessLogger;
+    builtinMetrics metricIDs;
+    frederick2::httpServer::ticketKeys *tickets;
 };
 
 #endif
\ No newline at end of file
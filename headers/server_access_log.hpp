@@ -0,0 +1,124 @@
+//
+// server_access_log.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SERVER_ACCESS_LOG_HPP
+#define SERVER_ACCESS_LOG_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <vector>
+
+#include "frederick2_namespace.hpp"
+#include "server_enum.hpp"
+
+class frederick2::httpServer::accessLog
+{
+public:
+    accessLog(const accessLog&) = delete;
+    accessLog& operator= (const accessLog&) = delete;
+    ~accessLog();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Friend Declarations
+    ///////////////////////////////////////////////////////////////////////////////
+    friend class frederick2::httpPacket::httpRequest;
+    friend class frederick2::httpServer::httpServer;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    static constexpr size_t routeCapacity{80};
+    static constexpr size_t ringCapacity{1024};
+    static constexpr size_t batchLimit{64 * 1024};
+    struct logEntry
+    {
+        uint64_t finishTicks;
+        uint64_t totalTicks;
+        uint64_t handlerTicks;
+        uint64_t bytesIn;
+        uint64_t bytesOut;
+        uint16_t status;
+        uint16_t peerPort;
+        uint8_t peerFamily;
+        uint8_t routeLength;
+        frederick2::httpEnums::httpMethod method;
+        std::array<uint8_t, 16> peerAddress;
+        std::array<char, routeCapacity> route;
+    };
+    struct ring
+    {
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+        std::atomic<uint64_t> dropped;
+        std::array<logEntry, ringCapacity> entries;
+        ring();
+    };
+    struct ringPool
+    {
+        std::mutex poolLock;
+        std::vector<std::unique_ptr<ring>> rings;
+        std::vector<ring*> freeRings;
+    };
+    struct ringLease
+    {
+        std::shared_ptr<ringPool> pool;
+        ring *local{nullptr};
+        void release();
+        ~ringLease();
+    };
+    struct formatToken
+    {
+        frederick2::httpEnums::logField field;
+        std::string literal;
+    };
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    explicit accessLog(const std::string&, const std::string&, size_t, size_t);
+    void appendEntry(std::string&, const logEntry&, double);
+    static void copyPeer(logEntry&, const struct sockaddr*);
+    size_t drain(std::string&);
+    size_t getDropped();
+    bool isOpen();
+    ring *localRing();
+    bool openFile(bool);
+    static std::vector<formatToken> parseFormat(const std::string&);
+    bool push(const logEntry&);
+    void rotate();
+    void writeBatch(std::string&);
+    void writerLoop();
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    int fileDescriptor;
+    size_t fileBytes;
+    size_t maxBytes;
+    size_t keepFiles;
+    uint64_t baseTicks;
+    std::chrono::system_clock::time_point baseWall;
+    std::string filePath;
+    std::vector<formatToken> tokens;
+    std::vector<ring*> drainRings;
+    std::shared_ptr<ringPool> pool;
+    std::atomic<bool> stopping;
+    std::mutex wakeLock;
+    std::condition_variable wakeWriter;
+    std::thread writer;
+    static thread_local ringLease localLease;
+};
+
+#endif
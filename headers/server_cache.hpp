@@ -0,0 +1,77 @@
+//
+// server_cache.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SERVER_CACHE_HPP
+#define SERVER_CACHE_HPP
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "frederick2_namespace.hpp"
+
+class frederick2::httpServer::responseCache
+{
+public:
+    responseCache(const responseCache&) = delete;
+    responseCache& operator= (const responseCache&) = delete;
+    ~responseCache();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Friend Declarations
+    ///////////////////////////////////////////////////////////////////////////////
+    friend class frederick2::httpServer::httpServer;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    struct cacheEntry
+    {
+        std::string key;
+        std::string etag;
+        std::string vary;
+        std::string cacheControl;
+        std::shared_ptr<const std::string> payload;
+        size_t headLength;
+        size_t bytes;
+        std::chrono::steady_clock::time_point stored;
+        std::chrono::steady_clock::time_point expires;
+    };
+    typedef std::list<cacheEntry> entryLIST;
+    struct cacheShard
+    {
+        std::mutex lock;
+        size_t bytes;
+        entryLIST lru;
+        std::unordered_map<std::string, entryLIST::iterator> index;
+    };
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    explicit responseCache(size_t);
+    static std::string buildETag(const std::string&);
+    bool fetch(const std::string&, std::shared_ptr<const std::string>&, size_t&, std::string&, std::string&, std::string&, long&);
+    cacheShard *getShard(const std::string&);
+    static bool matchETag(std::string_view, std::string_view);
+    static bool parseCacheControl(const std::string&, bool&, bool&, long&);
+    void store(const std::string&, std::string&&, size_t, const std::string&, const std::string&, const std::string&, size_t);
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    size_t shardBudget;
+    size_t shardMask;
+    std::vector<std::unique_ptr<cacheShard>> shards;
+};
+
+#endif
@@ -15,8 +15,10 @@
 #include <openssl/ssl.h>
 #include <string>
 #include <sys/socket.h>
+#include <vector>
 
 #include "frederick2_namespace.hpp"
+#include "parse_header_line.hpp"
 #include "server.hpp"
 #include "server_socket.hpp"
 
@@ -30,6 +32,7 @@ private:
     ///////////////////////////////////////////////////////////////////////////////
     // Friend Declarations
     ///////////////////////////////////////////////////////////////////////////////
+    friend class frederick2::httpServer::http2Session;
     friend class frederick2::httpServer::httpServer;
     ///////////////////////////////////////////////////////////////////////////////
     // Private Functions
@@ -37,33 +40,53 @@ private:
     explicit connection(frederick2::httpServer::httpServer*);
     bool acceptConnection(int);    
     void close();
+    bool detectHTTP2();
     bool handleConnection(std::future<void>);
     bool handleIO(std::future<void>);
+    bool handshakeSSL();
+    void holdMemory(size_t);
     void readData();
     void readDataSSL();
+    bool requestBuffered();
+    void reset();
     void sendData(std::string);
     void sendDataSSL(std::string);
+    void sendFile(int, size_t);
+    void setHandshakePool(frederick2::httpServer::handshakePool*);
+    void setHandshakeTime(size_t);
     void setMaxTime(size_t);
     void setSSLContext(SSL_CTX*);
     void setSSLPrivateKey(const std::string&);
     void setSSLPublicCert(const std::string&);
+    void setUseHTTP2(bool);
     void setUseSSL(bool);
     void shutdownSSLConnection();    
     ///////////////////////////////////////////////////////////////////////////////
     // Private Properties
     ///////////////////////////////////////////////////////////////////////////////
     bool connectionError;
+    bool useHTTP2;
     bool useSSL;
     bool sslActive;
+    bool ktlsSend;
+    size_t bytesSinceIdle;
+    size_t handshakeTime;
+    size_t memoryHeld;
     size_t maxTime;
+    uint64_t acceptTicks;
     SSL_CTX *sslContext;
     SSL *sslConnection;
     socklen_t addressLength;
     struct sockaddr address;
+    std::chrono::steady_clock::time_point lastSend;
+    std::vector<char> ioBuffer;
+    std::string probeBuffer;
     std::string receiveBuffer;
     std::string sendBuffer;
     std::string sslCertPath;
     std::string sslKeyPath;
+    frederick2::httpPacket::headerLineParser probeParser;
+    frederick2::httpServer::handshakePool *cryptoPool;
     frederick2::httpServer::httpServer *host;
     frederick2::httpServer::socket *sock;
 };
@@ -12,6 +12,46 @@
 
 #include "frederick2_namespace.hpp"
 
+enum class frederick2::httpEnums::contentCoding
+{
+    ENUMERROR,
+    IDENTITY,
+    DEFLATE,
+    GZIP
+};
+
+enum class frederick2::httpEnums::h2ErrorCode
+{
+    NO_ERROR = 0x0,
+    PROTOCOL_ERROR = 0x1,
+    INTERNAL_ERROR = 0x2,
+    FLOW_CONTROL_ERROR = 0x3,
+    SETTINGS_TIMEOUT = 0x4,
+    STREAM_CLOSED = 0x5,
+    FRAME_SIZE_ERROR = 0x6,
+    REFUSED_STREAM = 0x7,
+    CANCEL = 0x8,
+    COMPRESSION_ERROR = 0x9,
+    CONNECT_ERROR = 0xa,
+    ENHANCE_YOUR_CALM = 0xb,
+    INADEQUATE_SECURITY = 0xc,
+    HTTP_1_1_REQUIRED = 0xd
+};
+
+enum class frederick2::httpEnums::h2FrameType
+{
+    DATA = 0x0,
+    HEADERS = 0x1,
+    PRIORITY = 0x2,
+    RST_STREAM = 0x3,
+    SETTINGS = 0x4,
+    PUSH_PROMISE = 0x5,
+    PING = 0x6,
+    GOAWAY = 0x7,
+    WINDOW_UPDATE = 0x8,
+    CONTINUATION = 0x9
+};
+
 enum class frederick2::httpEnums::httpMethod
 {   
     ENUMERROR,
@@ -114,6 +154,50 @@ enum class frederick2::httpEnums::httpStatus
     NETWORK_AUTHENTICATION_REQUIRED = 511    
 };
 
+enum class frederick2::httpEnums::latencyStage
+{
+    QUEUE,
+    TLS,
+    HEADERS,
+    BODY,
+    HANDLER,
+    SEND,
+    TOTAL
+};
+
+enum class frederick2::httpEnums::logField
+{
+    LITERAL,
+    BYTES_IN,
+    BYTES_OUT,
+    HANDLER_TIME,
+    METHOD,
+    PEER,
+    ROUTE,
+    STATUS,
+    TIME,
+    TIME_ISO,
+    TOTAL_TIME
+};
+
+enum class frederick2::httpEnums::metricType
+{
+    COUNTER,
+    GAUGE,
+    HISTOGRAM
+};
+
+enum class frederick2::httpEnums::paramType
+{
+    ENUMERROR,
+    STRING,
+    INT64,
+    UUID,
+    HEX,
+    ENUMSET,
+    REGEX
+};
+
 enum class frederick2::httpEnums::resourceType
 {
     ENUMERROR,
@@ -0,0 +1,68 @@
+//
+// server_handshake.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SERVER_HANDSHAKE_HPP
+#define SERVER_HANDSHAKE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <openssl/ssl.h>
+#include <thread>
+#include <vector>
+
+#include "frederick2_namespace.hpp"
+
+class frederick2::httpServer::handshakePool
+{
+public:
+    handshakePool(const handshakePool&) = delete;
+    handshakePool& operator= (const handshakePool&) = delete;
+    ~handshakePool();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Friend Declarations
+    ///////////////////////////////////////////////////////////////////////////////
+    friend class frederick2::httpServer::connection;
+    friend class frederick2::httpServer::httpServer;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    struct stepTask
+    {
+        SSL *sslConnection;
+        int result;
+        int sslError;
+        bool done;
+    };
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    explicit handshakePool(size_t, size_t);
+    size_t getQueueDepth();
+    bool runStep(SSL*, int&, int&, std::chrono::steady_clock::time_point);
+    void workerLoop();
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    bool stopping;
+    size_t maxQueue;
+    std::atomic<size_t> queuePeak;
+    std::atomic<size_t> rejected;
+    std::deque<stepTask*> pending;
+    std::mutex poolLock;
+    std::condition_variable taskReady;
+    std::condition_variable taskDone;
+    std::vector<std::thread> workers;
+};
+
+#endif
@@ -0,0 +1,112 @@
+//
+// server_http2.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SERVER_HTTP2_HPP
+#define SERVER_HTTP2_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <openssl/ssl.h>
+#include <string>
+
+#include "frederick2_namespace.hpp"
+#include "server_enum.hpp"
+#include "utility_hpack.hpp"
+
+class frederick2::httpServer::http2Session
+{
+public:
+    http2Session(const http2Session&) = delete;
+    http2Session& operator= (const http2Session&) = delete;
+    ~http2Session();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Friend Declarations
+    ///////////////////////////////////////////////////////////////////////////////
+    friend class frederick2::httpServer::connection;
+    friend class frederick2::httpServer::httpServer;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    struct streamState
+    {
+        uint32_t streamID;
+        int weight;
+        bool headersDone;
+        bool endStreamPending;
+        bool remoteClosed;
+        bool refused;
+        bool dispatched;
+        bool queued;
+        bool headersSent;
+        bool cancelled;
+        int64_t sendWindow;
+        int64_t recvWindow;
+        int64_t recvPending;
+        uint64_t virtualFinish;
+        uint64_t openedTicks;
+        size_t bodyOffset;
+        std::string headerBlock;
+        std::string requestBody;
+        std::string responseBody;
+        strPairVECTOR requestFields;
+        std::packaged_task<std::string()> task;
+        std::future<std::string> response;
+    };
+    typedef std::map<uint32_t, std::unique_ptr<streamState>> streamMAP;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    explicit http2Session(frederick2::httpServer::connection*, frederick2::httpServer::httpServer*);
+    static bool buildRequestText(streamState*, std::string&);
+    void collectResponses();
+    bool dispatchStream(streamState*);
+    bool finishHeaders(streamState*);
+    void flush();
+    std::string handleStream(std::string, uint64_t);
+    bool processFrame(frederick2::httpEnums::h2FrameType, uint8_t, uint32_t, const char*, size_t);
+    bool processFrames();
+    bool processSettings(uint8_t, const char*, size_t);
+    void queueFrame(frederick2::httpEnums::h2FrameType, uint8_t, uint32_t, const char*, size_t);
+    void queueGoaway(frederick2::httpEnums::h2ErrorCode);
+    void queueHeaders(uint32_t, const std::string&, bool);
+    void queueReset(uint32_t, frederick2::httpEnums::h2ErrorCode);
+    void queueWindowUpdate(uint32_t, uint32_t);
+    bool readPreface();
+    void replenishWindows();
+    bool run(std::future<void>&);
+    static int selectProtocol(SSL*, const unsigned char**, unsigned char*, const unsigned char*, unsigned int, void*);
+    static bool splitResponse(const std::string&, strPairVECTOR&, std::string&);
+    void submitQueued();
+    void writeData();
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    bool goawayReceived;
+    bool goawaySent;
+    uint32_t continuationStream;
+    uint32_t lastStreamID;
+    uint32_t peerInitialWindow;
+    uint32_t peerMaxFrame;
+    int64_t connSendWindow;
+    int64_t connRecvWindow;
+    uint64_t virtualClock;
+    std::string outBuffer;
+    std::chrono::steady_clock::time_point lastActivity;
+    streamMAP streams;
+    frederick2::utility::hpack headerCodec;
+    frederick2::httpServer::connection *conn;
+    frederick2::httpServer::httpServer *host;
+};
+
+#endif
@@ -0,0 +1,52 @@
+//
+// server_memory.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SERVER_MEMORY_HPP
+#define SERVER_MEMORY_HPP
+
+#include <atomic>
+
+#include "frederick2_namespace.hpp"
+
+class frederick2::httpServer::memoryGovernor
+{
+public:
+    memoryGovernor(const memoryGovernor&) = delete;
+    memoryGovernor& operator= (const memoryGovernor&) = delete;
+    ~memoryGovernor();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Friend Declarations
+    ///////////////////////////////////////////////////////////////////////////////
+    friend class frederick2::httpPacket::httpRequest;
+    friend class frederick2::httpServer::connection;
+    friend class frederick2::httpServer::http2Session;
+    friend class frederick2::httpServer::httpServer;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    explicit memoryGovernor();
+    void adjust(size_t, size_t);
+    size_t getUsage();
+    bool overHardLimit();
+    bool overSoftLimit();
+    void setLimits(size_t, size_t);
+    bool shouldPause(size_t);
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    size_t softLimit;
+    size_t hardLimit;
+    size_t retryAfter;
+    std::atomic<size_t> holders;
+    std::atomic<size_t> usage;
+};
+
+#endif
@@ -0,0 +1,125 @@
+//
+// server_metrics.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SERVER_METRICS_HPP
+#define SERVER_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "frederick2_namespace.hpp"
+#include "server_enum.hpp"
+#include "utility_arena.hpp"
+
+class frederick2::httpServer::metricsRegistry
+{
+public:
+    explicit metricsRegistry();
+    metricsRegistry(const metricsRegistry&) = delete;
+    metricsRegistry& operator= (const metricsRegistry&) = delete;
+    void add(size_t, int64_t);
+    size_t addCounter(const std::string&, const std::string&, const strVECTOR&);
+    size_t addGauge(const std::string&, const std::string&, const strVECTOR&);
+    void addGaugeFunction(const std::string&, const std::string&, std::function<double()>);
+    size_t addHistogram(const std::string&, const std::string&, const std::vector<double>&, const strVECTOR&);
+    size_t addLatencyHistogram(const std::string&, const std::string&, const strVECTOR&);
+    size_t getSeries(size_t, std::initializer_list<std::string_view>);
+    void increment(size_t);
+    void observe(size_t, double);
+    void observeTicks(size_t, uint64_t);
+    void observeTicks(const size_t*, const uint64_t*, size_t);
+    double quantile(size_t, double);
+    std::string render();
+    ~metricsRegistry();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    static constexpr size_t pageSlots{1024};
+    static constexpr size_t pageCount{64};
+    static constexpr size_t slotCapacity{pageSlots * pageCount};
+    static constexpr size_t latencySubBits{3};
+    static constexpr size_t latencySubCount{1 << latencySubBits};
+    static constexpr size_t latencyMaxExponent{40};
+    static constexpr size_t latencyBuckets{(latencyMaxExponent - latencySubBits + 2) * latencySubCount};
+    struct alignas(64) slotPage
+    {
+        std::array<std::atomic<uint64_t>, pageSlots> slots;
+    };
+    struct shard
+    {
+        std::array<std::atomic<slotPage*>, pageCount> pages;
+        shard();
+        ~shard();
+    };
+    struct shardPool
+    {
+        std::mutex poolLock;
+        std::vector<std::unique_ptr<shard>> shards;
+        std::vector<shard*> freeShards;
+    };
+    struct shardLease
+    {
+        std::shared_ptr<shardPool> pool;
+        shard *local{nullptr};
+        std::string keyScratch;
+        std::map<std::string, size_t, frederick2::utility::viewLess> seriesCache;
+        void release();
+        ~shardLease();
+    };
+    struct metricFamily
+    {
+        std::string name;
+        std::string help;
+        frederick2::httpEnums::metricType type;
+        bool logLinear;
+        strVECTOR labelNames;
+        std::vector<double> bounds;
+        std::vector<size_t> seriesSlots;
+        std::vector<std::string> seriesLabels;
+        std::function<double()> sampler;
+    };
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    size_t addFamily(const std::string&, const std::string&, frederick2::httpEnums::metricType, const std::vector<double>&, const strVECTOR&);
+    static slotPage *addPage(std::atomic<slotPage*>&);
+    static void appendNumber(std::string&, double);
+    static void appendLabelValue(std::string&, std::string_view);
+    static void bump(std::atomic<uint64_t>&, uint64_t);
+    static size_t latencyBucket(uint64_t);
+    static uint64_t latencyBucketEnd(size_t);
+    shard *localShard();
+    static std::atomic<uint64_t>& shardSlot(shard*, size_t);
+    double sumDouble(size_t);
+    uint64_t sumSlot(size_t);
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    size_t slotsUsed;
+    std::mutex registryLock;
+    std::deque<metricFamily> families;
+    std::map<std::string, size_t> seriesIndex;
+    std::array<const metricFamily*, slotCapacity> slotFamily;
+    std::shared_ptr<shardPool> pool;
+    static thread_local shardLease localLease;
+};
+
+#endif
@@ -0,0 +1,48 @@
+//
+// server_middleware.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SERVER_MIDDLEWARE_HPP
+#define SERVER_MIDDLEWARE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "frederick2_namespace.hpp"
+#include "server.hpp"
+
+class frederick2::httpServer::middlewareChain
+{
+public:
+    middlewareChain(const middlewareChain&) = delete;
+    middlewareChain& operator= (const middlewareChain&) = delete;
+    void next();
+    ~middlewareChain();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Friend Declarations
+    ///////////////////////////////////////////////////////////////////////////////
+    friend class frederick2::httpServer::httpServer;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    explicit middlewareChain(const std::vector<const httpMiddleware*>*, frederick2::httpPacket::httpRequest*, frederick2::httpPacket::httpResponse*, frederick2::httpServer::httpServer*, frederick2::httpServer::httpServer::dispatchState*);
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    bool dispatched;
+    size_t position;
+    const std::vector<const httpMiddleware*> *calls;
+    frederick2::httpPacket::httpRequest *inbound;
+    frederick2::httpPacket::httpResponse *outbound;
+    frederick2::httpServer::httpServer *host;
+    frederick2::httpServer::httpServer::dispatchState *state;
+};
+
+#endif
@@ -10,21 +10,32 @@
 #ifndef SERVER_RESOURCE_HPP
 #define SERVER_RESOURCE_HPP
 
+#include <array>
+#include <memory>
+#include <regex>
 #include <string>
+#include <vector>
 
 #include "frederick2_namespace.hpp"
+#include "server_enum.hpp"
 
 class frederick2::httpServer::resource
 {
 public:
     frederick2::httpServer::resource* addChild(const std::string&, frederick2::httpEnums::resourceType);
+    void addCacheVary(const std::string&);
     void addHandler(frederick2::httpEnums::httpMethod, httpHandler);
+    void addMiddleware(httpMiddleware);
     frederick2::httpServer::resource* getChild(const std::string&);
     handlerCheck getHandler(frederick2::httpEnums::httpMethod);
     std::string getMethodList();
     std::string getName();
     frederick2::httpEnums::resourceType getType();
     void removeChild(const std::string&);
+    void setCacheTTL(size_t);
+    void setParameterChoices(const strVECTOR&);
+    void setParameterPattern(const std::string&);
+    void setParameterType(frederick2::httpEnums::paramType);
     ~resource();
 protected:
 private:
@@ -32,18 +43,36 @@ private:
     // Friend Declarations
     ///////////////////////////////////////////////////////////////////////////////
     friend class frederick2::httpServer::httpServer;
+    friend class frederick2::httpServer::routeTable;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    static constexpr size_t methodCount{static_cast<size_t>(frederick2::httpEnums::httpMethod::TRACE) + 1};
+    static constexpr size_t stageCount{static_cast<size_t>(frederick2::httpEnums::latencyStage::TOTAL) + 1};
     ///////////////////////////////////////////////////////////////////////////////
     // Private Functions
     ///////////////////////////////////////////////////////////////////////////////
     explicit resource(const std::string&, frederick2::httpEnums::resourceType);
+    frederick2::httpServer::resource *clone();
+    const httpHandler *findHandler(frederick2::httpEnums::httpMethod) const;
     ///////////////////////////////////////////////////////////////////////////////
     // Private Properties
     ///////////////////////////////////////////////////////////////////////////////
     bool hasDynamic;
     bool hasFilesystem;
+    size_t cacheTTL;
+    std::string allowList;
     std::string name;
+    std::string routePath;
+    strVECTOR cacheVary;
+    strVECTOR paramChoices;
     strMAPresource children;
-    methodMAPhandler handlers;
+    std::array<httpHandler, methodCount> handlers;
+    std::array<size_t, stageCount> stageSeries;
+    std::vector<httpMiddleware> middleware;
+    std::vector<const httpMiddleware*> pipeline;
+    std::shared_ptr<const std::regex> paramPattern;
+    frederick2::httpEnums::paramType paramKind;
     frederick2::httpEnums::resourceType type;
 };
 
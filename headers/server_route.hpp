@@ -0,0 +1,67 @@
+//
+// server_route.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SERVER_ROUTE_HPP
+#define SERVER_ROUTE_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "frederick2_namespace.hpp"
+#include "server_enum.hpp"
+
+class frederick2::httpServer::routeTable
+{
+public:
+    routeTable(const routeTable&) = delete;
+    routeTable& operator= (const routeTable&) = delete;
+    ~routeTable();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Friend Declarations
+    ///////////////////////////////////////////////////////////////////////////////
+    friend class frederick2::httpServer::httpServer;
+    friend class frederick2::httpServer::routeRegistry;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    struct routeEdge
+    {
+        uint32_t labelOffset;
+        uint32_t labelLength;
+        uint32_t node;
+    };
+    struct routeNode
+    {
+        frederick2::httpServer::resource *target;
+        frederick2::httpEnums::resourceType kind;
+        uint32_t firstEdge;
+        uint32_t edgeCount;
+        int32_t dynamicNode;
+    };
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    explicit routeTable(frederick2::httpServer::resource*);
+    int32_t findStatic(const routeNode&, std::string_view, bool) const;
+    frederick2::httpServer::resource *match(frederick2::httpPacket::httpRequest*) const;
+    static frederick2::httpEnums::httpStatus parseParameter(const frederick2::httpServer::resource*, std::string_view, frederick2::httpPacket::httpRequest*);
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    std::string labels;
+    std::vector<routeEdge> edges;
+    std::vector<routeNode> nodes;
+    frederick2::httpServer::resource *snapshotRoot;
+};
+
+#endif
@@ -0,0 +1,79 @@
+//
+// server_route_registry.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SERVER_ROUTE_REGISTRY_HPP
+#define SERVER_ROUTE_REGISTRY_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "frederick2_namespace.hpp"
+
+class frederick2::httpServer::routeRegistry
+{
+public:
+    routeRegistry(const routeRegistry&) = delete;
+    routeRegistry& operator= (const routeRegistry&) = delete;
+    ~routeRegistry();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Friend Declarations
+    ///////////////////////////////////////////////////////////////////////////////
+    friend class frederick2::httpServer::httpServer;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    struct alignas(64) readerSlot
+    {
+        std::atomic<uint64_t> epoch;
+        std::atomic<bool> claimed;
+        uint32_t depth;
+        readerSlot();
+    };
+    struct slotOwner
+    {
+        readerSlot *slot;
+        slotOwner();
+        ~slotOwner();
+    };
+    struct readGuard
+    {
+        readerSlot *slot;
+        const frederick2::httpServer::routeTable *table;
+        explicit readGuard(frederick2::httpServer::routeRegistry*);
+        readGuard(const readGuard&) = delete;
+        readGuard& operator= (const readGuard&) = delete;
+        ~readGuard();
+    };
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    explicit routeRegistry();
+    static readerSlot *localSlot();
+    void reclaim();
+    void update(frederick2::httpServer::resource*, const std::function<void(frederick2::httpServer::resource*)>&, const std::function<void(frederick2::httpServer::routeTable*)>&);
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    std::atomic<frederick2::httpServer::routeTable*> current;
+    std::mutex writeLock;
+    std::vector<std::pair<uint64_t, frederick2::httpServer::routeTable*>> retired;
+    static std::atomic<uint64_t> globalEpoch;
+    static std::mutex slotLock;
+    static std::deque<readerSlot> slots;
+    static thread_local slotOwner localOwner;
+};
+
+#endif
@@ -28,6 +28,7 @@ private:
     ///////////////////////////////////////////////////////////////////////////////
     friend class frederick2::httpServer::httpServer;
     friend class frederick2::httpServer::connection;
+    friend class frederick2::httpServer::http2Session;
     ///////////////////////////////////////////////////////////////////////////////
     // Private Functions
     ///////////////////////////////////////////////////////////////////////////////
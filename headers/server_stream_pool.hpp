@@ -0,0 +1,60 @@
+//
+// server_stream_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SERVER_STREAM_POOL_HPP
+#define SERVER_STREAM_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "frederick2_namespace.hpp"
+
+class frederick2::httpServer::streamPool
+{
+public:
+    streamPool(const streamPool&) = delete;
+    streamPool& operator= (const streamPool&) = delete;
+    ~streamPool();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Friend Declarations
+    ///////////////////////////////////////////////////////////////////////////////
+    friend class frederick2::httpServer::http2Session;
+    friend class frederick2::httpServer::httpServer;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    typedef std::packaged_task<std::string()> streamTask;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    explicit streamPool(size_t, size_t);
+    size_t getQueueDepth();
+    bool submit(streamTask&);
+    void workerLoop();
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    bool stopping;
+    size_t maxQueue;
+    std::atomic<size_t> queuePeak;
+    std::deque<streamTask> pending;
+    std::mutex poolLock;
+    std::condition_variable taskReady;
+    std::vector<std::thread> workers;
+};
+
+#endif
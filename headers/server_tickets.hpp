@@ -0,0 +1,62 @@
+//
+// server_tickets.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SERVER_TICKETS_HPP
+#define SERVER_TICKETS_HPP
+
+#include <chrono>
+#include <mutex>
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+
+#include "frederick2_namespace.hpp"
+
+class frederick2::httpServer::ticketKeys
+{
+public:
+    ticketKeys(const ticketKeys&) = delete;
+    ticketKeys& operator= (const ticketKeys&) = delete;
+    ~ticketKeys();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Friend Declarations
+    ///////////////////////////////////////////////////////////////////////////////
+    friend class frederick2::httpServer::httpServer;
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    struct ticketKey
+    {
+        bool valid;
+        unsigned char name[16];
+        unsigned char aesKey[32];
+        unsigned char hmacKey[32];
+    };
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    explicit ticketKeys(size_t);
+    bool attach(SSL_CTX*);
+    static int ticketCallback(SSL*, unsigned char*, unsigned char*, EVP_CIPHER_CTX*, EVP_MAC_CTX*, int);
+    bool generateKey(ticketKey&);
+    void rotate();
+    static bool setMacKey(EVP_MAC_CTX*, unsigned char*);
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    static int exDataIndex;
+    size_t rotationSeconds;
+    ticketKey currentKey;
+    ticketKey previousKey;
+    std::mutex keyLock;
+    std::chrono::steady_clock::time_point rotatedAt;
+};
+
+#endif
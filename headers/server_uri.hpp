@@ -12,6 +12,7 @@
 
 #include <deque>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -22,26 +23,27 @@ class frederick2::httpServer::uri
 {
 public:
     uri();
-    std::vector<std::string> getFragments();
-    std::string getFragmentString();
-    strMAPstr getParameters();
-    std::string getParameterString();
-    std::string getHost();
-    frederick2::httpEnums::uriHostType getHostType();
-    std::string getPassword();
-    std::string getPathString();
-    int getPort();
-    frederick2::httpEnums::uriScheme getScheme();
-    std::deque<std::string> getSegments();
-    std::string getURIString();
-    std::string getUsername();
-    bool hasFragments();
-    bool hasHost();
-    bool hasParameters();
-    bool hasPath();
-    bool hasPort();
-    bool hasScheme();
-    bool hasUserInfo();
+    const std::vector<std::string>& getFragments() const;
+    const std::string& getFragmentString() const;
+    const strMAPstr& getParameters() const;
+    const std::string& getParameterString() const;
+    const std::string& getHost() const;
+    frederick2::httpEnums::uriHostType getHostType() const;
+    const std::string& getPassword() const;
+    std::string getPathString() const;
+    const std::string& getRawPath() const;
+    int getPort() const;
+    frederick2::httpEnums::uriScheme getScheme() const;
+    const std::deque<std::string>& getSegments() const;
+    const std::string& getURIString() const;
+    const std::string& getUsername() const;
+    bool hasFragments() const;
+    bool hasHost() const;
+    bool hasParameters() const;
+    bool hasPath() const;
+    bool hasPort() const;
+    bool hasScheme() const;
+    bool hasUserInfo() const;
     void addFragment(const std::string&);
     void addParameter(const std::string&, const std::string&);
     void addSegment(const std::string&);
@@ -51,6 +53,7 @@ public:
     void setParameterString(const std::string&);
     void setPassword(const std::string&);
     void setPort(int);
+    void setRawPath(const std::string&);
     void setScheme(frederick2::httpEnums::uriScheme);
     void setURIString(const std::string&);
     void setUserInfo(const std::string&, const std::string&);
@@ -58,6 +61,12 @@ public:
     ~uri();
 protected:
 private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Friend Declarations
+    ///////////////////////////////////////////////////////////////////////////////
+    friend class frederick2::httpPacket::httpRequest;
+    friend class frederick2::httpServer::httpServer;
+    friend class frederick2::httpServer::routeTable;
     ///////////////////////////////////////////////////////////////////////////////
     // Private Properties
     ///////////////////////////////////////////////////////////////////////////////
@@ -74,9 +83,10 @@ private:
     std::string fullURIString;
     std::string host;
     std::string password;
+    std::string rawPath;
     std::string username;
     strMAPstr parameters;
-    std::deque<std::string> segments;
+    mutable std::optional<std::deque<std::string>> segments;
     std::vector<std::string> fragments;    
     frederick2::httpEnums::uriHostType hostType;
     frederick2::httpEnums::uriScheme scheme;
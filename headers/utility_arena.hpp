@@ -0,0 +1,46 @@
+//
+// utility_arena.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UTILITY_ARENA_HPP
+#define UTILITY_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+
+#include "frederick2_namespace.hpp"
+
+class frederick2::utility::requestArena
+{
+public:
+    requestArena();
+    requestArena(const requestArena&) = delete;
+    requestArena& operator= (const requestArena&) = delete;
+    std::pmr::memory_resource *getResource();
+    void rewind();
+    ~requestArena();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    static constexpr size_t blockSize{16384};
+    std::unique_ptr<std::byte[]> block;
+    std::pmr::monotonic_buffer_resource monotonic;
+};
+
+class frederick2::utility::viewLess
+{
+public:
+    typedef void is_transparent;
+    bool operator()(std::string_view lhs, std::string_view rhs) const { return(lhs < rhs); }
+};
+
+#endif
@@ -0,0 +1,64 @@
+//
+// utility_clock.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UTILITY_CLOCK_HPP
+#define UTILITY_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+#include "frederick2_namespace.hpp"
+
+class frederick2::utility::cycleClock
+{
+public:
+    ///////////////////////////////////////////////////////////////////////////////
+    // raw ticks for stage timing: the TSC when CPUID reports it invariant
+    // (checked once at startup), steady_clock nanoseconds otherwise.
+    // inline so a stamp stays a single instruction on the request path
+    ///////////////////////////////////////////////////////////////////////////////
+    static uint64_t now()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        if(invariantTSC)
+        {
+            return(__rdtsc());
+        }
+#endif
+        return(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()));
+    }
+    static double secondsPerTick();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    struct clockPair
+    {
+        uint64_t ticks;
+        std::chrono::steady_clock::time_point steady;
+        clockPair();
+    };
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    static bool detectInvariantTSC();
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    static const bool invariantTSC;
+    static const clockPair baseline;
+};
+
+#endif
@@ -0,0 +1,54 @@
+//
+// utility_compress.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UTILITY_COMPRESS_HPP
+#define UTILITY_COMPRESS_HPP
+
+#include <string>
+#include <zlib.h>
+
+#include "frederick2_namespace.hpp"
+#include "server_enum.hpp"
+
+class frederick2::utility::compressor
+{
+public:
+    explicit compressor(frederick2::httpEnums::contentCoding);
+    compressor(const compressor&) = delete;
+    compressor& operator= (const compressor&) = delete;
+    bool compress(const std::string&, strVECTOR&, size_t);
+    static std::string coding2str(frederick2::httpEnums::contentCoding);
+    static frederick2::httpEnums::contentCoding negotiate(const std::string&);
+    ~compressor();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    struct deflateState
+    {
+        bool ready;
+        z_stream stream;
+        deflateState();
+        ~deflateState();
+    };
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    static z_stream *acquireStream(frederick2::httpEnums::contentCoding);
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    frederick2::httpEnums::contentCoding coding;
+    z_stream *stream;
+    static thread_local deflateState gzipState;
+    static thread_local deflateState zlibState;
+};
+
+#endif
@@ -0,0 +1,46 @@
+//
+// utility_header.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UTILITY_HEADER_HPP
+#define UTILITY_HEADER_HPP
+
+#include <ctime>
+#include <string>
+
+#include "frederick2_namespace.hpp"
+
+class frederick2::utility::headerCache
+{
+public:
+    headerCache() = delete;
+    static void appendCommonHeaders(std::string&, bool, bool);
+    static const std::string& getDate();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    struct dateState
+    {
+        time_t lastSecond;
+        std::string dateValue;
+        std::string headerBlock;
+        dateState();
+    };
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    static dateState& refresh();
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    static thread_local dateState localState;
+};
+
+#endif
@@ -0,0 +1,60 @@
+//
+// utility_header_list.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UTILITY_HEADER_LIST_HPP
+#define UTILITY_HEADER_LIST_HPP
+
+#include <string>
+#include <vector>
+
+#include "frederick2_namespace.hpp"
+
+class frederick2::utility::headerList
+{
+public:
+    headerList();
+    void append(const std::string&, const std::string&);
+    void clear();
+    void collectNames(std::vector<std::string>&) const;
+    const std::string *find(const std::string&) const;
+    bool has(const std::string&) const;
+    void remove(const std::string&);
+    void serialize(std::string&) const;
+    void serialize(std::string&, const std::vector<std::string>&) const;
+    size_t serializedSize() const;
+    void set(const std::string&, const std::string&);
+    size_t size() const;
+    ~headerList();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    struct headerEntry
+    {
+        std::string name;
+        std::string value;
+    };
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    headerEntry& entryAt(size_t);
+    const headerEntry& entryAt(size_t) const;
+    static bool nameEquals(const std::string&, const std::string&);
+    void removeFrom(size_t, const std::string&);
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    static constexpr size_t inlineCapacity{12};
+    size_t entryCount;
+    headerEntry inlineEntries[inlineCapacity];
+    std::vector<headerEntry> overflowEntries;
+};
+
+#endif
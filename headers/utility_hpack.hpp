@@ -0,0 +1,67 @@
+//
+// utility_hpack.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UTILITY_HPACK_HPP
+#define UTILITY_HPACK_HPP
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "frederick2_namespace.hpp"
+
+class frederick2::utility::hpack
+{
+public:
+    hpack();
+    bool decode(const std::string&, strPairVECTOR&);
+    void encode(const strPairVECTOR&, std::string&);
+    void setEncoderLimit(size_t);
+    ~hpack();
+protected:
+private:
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Types
+    ///////////////////////////////////////////////////////////////////////////////
+    struct dynamicTable
+    {
+        std::deque<std::pair<std::string, std::string>> entries;
+        size_t size;
+        size_t maxSize;
+        void add(const std::string&, const std::string&);
+        void resize(size_t);
+    };
+    struct huffmanNode
+    {
+        int child[2];
+        int symbol;
+    };
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Functions
+    ///////////////////////////////////////////////////////////////////////////////
+    static bool decodeHuffman(const char*, size_t, std::string&);
+    static bool decodeInteger(const std::string&, size_t&, int, size_t&);
+    static bool decodeString(const std::string&, size_t&, std::string&);
+    static void encodeHuffman(const std::string&, std::string&);
+    static void encodeInteger(size_t, int, unsigned char, std::string&);
+    static void encodeString(const std::string&, std::string&);
+    size_t findField(const std::string&, const std::string&, bool&);
+    static const std::vector<huffmanNode>& getHuffmanTree();
+    bool lookup(size_t, std::string&, std::string&);
+    ///////////////////////////////////////////////////////////////////////////////
+    // Private Properties
+    ///////////////////////////////////////////////////////////////////////////////
+    bool encoderResized;
+    dynamicTable decoderTable;
+    dynamicTable encoderTable;
+};
+
+#endif
@@ -11,6 +11,7 @@
 #define UTILITY_PARSE_HPP
 
 #include <string>
+#include <string_view>
 
 #include "frederick2_namespace.hpp"
 
@@ -18,6 +19,7 @@ class frederick2::utility::parseUtilities
 {
 public:
     parseUtilities();
+    bool decodeSegment(std::string_view, std::string&);
     bool dqExtract(const std::string&, std::string&, bool);
     bool escapeReplace(const std::string&, std::string&);
     bool isHex(char);
@@ -8,22 +8,29 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <chrono>
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "../headers/frederick2_namespace.hpp"
 #include "../headers/http_request.hpp"
 #include "../headers/parse_content.hpp"
 #include "../headers/parse_header.hpp"
 #include "../headers/server_enum.hpp"
+#include "../headers/server_memory.hpp"
 #include "../headers/server_uri.hpp"
+#include "../headers/utility_clock.hpp"
+#include "../headers/utility_parse.hpp"
 
 namespace enums = frederick2::httpEnums;
 namespace packet = frederick2::httpPacket;
 namespace http = frederick2::httpServer;
+namespace utility = frederick2::utility;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // global variable definitions
@@ -34,7 +41,7 @@ namespace http = frederick2::httpServer;
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// frederick2::network::connection member definitions
+// frederick2::httpPacket::httpRequest member definitions
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -42,18 +49,17 @@ namespace http = frederick2::httpServer;
 ///////////////////////////////////////////////////////////////////////////////
 
 packet::httpRequest::httpRequest(std::string* inBuffer)
+    : arena{new utility::requestArena()},
+      cookies{arena->getResource()},
+      headers{arena->getResource()},
+      pathParameters{arena->getResource()}
 {
-    this->buffer = inBuffer;
-    this->hasContent = false;
-    this->contentChunked = false;
-    this->versionMajor = 1;
-    this->versionMinor = 1;
-    this->contentReceived = 0;
-    this->contentLength = 0;
-    this->bytesReceived = 0;
-    this->method = enums::httpMethod::OPTIONS;
-    this->protocol = enums::httpProtocol::HTTP;
-    this->requestStatus = enums::httpStatus::OK;
+    ///////////////////////////////////////////////////////////////////////////////
+    // header, cookie and path parameter containers live in an arena the
+    // request keeps for its whole life, including while the server pools it
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->reset(inBuffer);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -76,7 +82,15 @@ void packet::httpRequest::addFileSegment(const std::string& sName)
 
 void packet::httpRequest::addHeader(const std::string& hName, const std::string& hValue)
 {
-    this->headers[hName] = hValue;    
+    auto search{this->headers.find(hName)};
+    if(search == this->headers.end())
+    {
+        this->headers.emplace(std::string_view{hName}, std::string_view{hValue});
+    }
+    else
+    {
+        search->second.assign(hValue);
+    }
     return;
 }
 
@@ -84,9 +98,14 @@ void packet::httpRequest::addHeader(const std::string& hName, const std::string&
 // frederick2::httpPacket::httpRequest::addPathParameter
 ///////////////////////////////////////////////////////////////////////////////
 
-void packet::httpRequest::addPathParameter(const std::string& pName, const std::string& pValue)
+void packet::httpRequest::addPathParameter(std::string_view pName, std::string_view pValue)
 {
-    this->pathParameters[pName] = pValue;    
+    ///////////////////////////////////////////////////////////////////////////////
+    // views into the route's name and this request's raw path,
+    // decoded only when a handler asks for them
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->pathParameters.emplace_back(pName, pValue);
     return;
 }
 
@@ -96,30 +115,29 @@ void packet::httpRequest::addPathParameter(const std::string& pName, const std::
 
 bool packet::httpRequest::buildRequest()
 {
-    std::unique_ptr<packet::headerParser> headerParser{new packet::headerParser(this->buffer)};
+    packet::headerParser headerParser{this->buffer, this->arena->getResource()};
     
     ///////////////////////////////////////////////////////////////////////////////
     // Collect and Parse Out Header
     ///////////////////////////////////////////////////////////////////////////////
     
-    this->requestStatus = headerParser->execute();
+    this->requestStatus = headerParser.execute();
     if(this->requestStatus == enums::httpStatus::OK) 
     {
-        this->bytesReceived += headerParser->getBytesReceived();
-        this->cookies = headerParser->getCookies();
-        this->headers = headerParser->getHeaders();
-        this->versionMajor = headerParser->getMajorVersion();
-        this->method = headerParser->getMethod();
-        this->versionMinor = headerParser->getMinorVersion();
-        this->protocol = headerParser->getProtocol();            
-        this->originalRequestLine = headerParser->getRequestLineString();
-        this->uriObj = headerParser->getURI();
-        this->queryParameters = this->uriObj.getParameters();
-        this->originalURIString = headerParser->getURIString();
+        this->bytesReceived += headerParser.getBytesReceived();
+        this->cookies = headerParser.getCookies();
+        this->headers = headerParser.getHeaders();
+        this->versionMajor = headerParser.getMajorVersion();
+        this->method = headerParser.getMethod();
+        this->versionMinor = headerParser.getMinorVersion();
+        this->protocol = headerParser.getProtocol();            
+        this->originalRequestLine = headerParser.getRequestLineString();
+        this->uriObj = headerParser.getURI();
+        this->originalURIString = headerParser.getURIString();
     }
     else
     {
-        this->statusReason = headerParser->getStatusReason();
+        this->statusReason = headerParser.getStatusReason();
     }
             
     ///////////////////////////////////////////////////////////////////////////////
@@ -130,6 +148,7 @@ bool packet::httpRequest::buildRequest()
     {
         this->requestStatus = this->validateRequest();
     }
+    this->stages.headersDone = utility::cycleClock::now();
     
     ///////////////////////////////////////////////////////////////////////////////
     // Collect Content
@@ -137,8 +156,17 @@ bool packet::httpRequest::buildRequest()
     
     if(this->hasContent && this->requestStatus == enums::httpStatus::OK)
     {
-        this->requestStatus = this->collectRequestBody();
+        if(this->memory != nullptr && this->memory->overHardLimit())
+        {
+            this->requestStatus = enums::httpStatus::SERVICE_UNAVAILABLE;
+            this->statusReason = "Server memory limit reached";
+        }
+        else
+        {
+            this->requestStatus = this->collectRequestBody();
+        }
     }
+    this->stages.bodyDone = this->hasContent ? utility::cycleClock::now() : this->stages.headersDone;
 
     ///////////////////////////////////////////////////////////////////////////////
     // Release Buffer and Return
@@ -154,31 +182,48 @@ bool packet::httpRequest::buildRequest()
 
 enums::httpStatus packet::httpRequest::collectRequestBody()
 {
-    std::unique_ptr<packet::contentParser> bodyParser{new packet::contentParser(this->buffer)};
+    packet::contentParser bodyParser{this->buffer};
     if(this->contentChunked)
     {
-        this->requestStatus = bodyParser->executeChunked();
+        this->requestStatus = bodyParser.executeChunked();
     }
     else
     {
-        this->requestStatus = bodyParser->executeContinuous(this->contentLength);
+        this->requestStatus = bodyParser.executeContinuous(this->contentLength);
     }
     
     if(this->requestStatus == enums::httpStatus::OK)
     {
-        this->bytesReceived += bodyParser->getBytesReceived();
-        this->content = bodyParser->getContent();
-        this->contentLength = bodyParser->getContentLength();
-        this->contentReceived = bodyParser->getContentReceived();
+        this->bytesReceived += bodyParser.getBytesReceived();
+        this->content = bodyParser.getContent();
+        this->contentLength = bodyParser.getContentLength();
+        this->contentReceived = bodyParser.getContentReceived();
     }
     else
     {
-        this->statusReason = bodyParser->getStatusReason();
+        this->statusReason = bodyParser.getStatusReason();
     }
     
     return(this->requestStatus);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpRequest::findPathValue
+///////////////////////////////////////////////////////////////////////////////
+
+const packet::httpRequest::pathValue* packet::httpRequest::findPathValue(const std::string& pName, enums::paramType pType) const
+{
+    for(size_t index = 0; index < this->pathValueCount; index++)
+    {
+        const pathValue& curValue{this->pathValues[index]};
+        if(curValue.type == pType && curValue.name == pName)
+        {
+            return(&curValue);
+        }
+    }
+    return(nullptr);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpPacket::httpRequest::getContent
 ///////////////////////////////////////////////////////////////////////////////
@@ -188,13 +233,40 @@ std::string packet::httpRequest::getContent()
     return(this->content);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpRequest::getContentView
+///////////////////////////////////////////////////////////////////////////////
+
+std::string_view packet::httpRequest::getContentView() const
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // valid until the request is released or its content is taken
+    ///////////////////////////////////////////////////////////////////////////////
+
+    return(this->content);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpRequest::getCookieMap
+///////////////////////////////////////////////////////////////////////////////
+
+const pmrMAPstr& packet::httpRequest::getCookieMap() const
+{
+    return(this->cookies);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpPacket::httpRequest::getCookies
 ///////////////////////////////////////////////////////////////////////////////
 
 strMAPstr packet::httpRequest::getCookies()
 {
-    return(this->cookies);
+    strMAPstr returnMap;
+    for(const std::pair<const std::pmr::string, std::pmr::string>& cookie : this->cookies)
+    {
+        returnMap.emplace(cookie.first, cookie.second);
+    }
+    return(returnMap);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -214,25 +286,54 @@ std::string packet::httpRequest::getHeader(const std::string& hName)
 {
     std::string returnString;
     
-    try
+    auto search{this->headers.find(hName)};
+    if(search != this->headers.end())
     {
-        returnString = this->headers.at(hName);
-    }
-    catch(const std::out_of_range& e)
-    {
-        returnString.clear();
+        returnString.assign(search->second);
     }
     
     return(std::move(returnString));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpRequest::getHeaderMap
+///////////////////////////////////////////////////////////////////////////////
+
+const pmrMAPstr& packet::httpRequest::getHeaderMap() const
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // the map lives in the request arena; copy anything kept past the handler
+    ///////////////////////////////////////////////////////////////////////////////
+
+    return(this->headers);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpPacket::httpRequest::getHeaders
 ///////////////////////////////////////////////////////////////////////////////
 
 strMAPstr packet::httpRequest::getHeaders()
 {
-    return(this->headers);
+    strMAPstr returnMap;
+    for(const std::pair<const std::pmr::string, std::pmr::string>& header : this->headers)
+    {
+        returnMap.emplace(header.first, header.second);
+    }
+    return(returnMap);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpRequest::getHeaderView
+///////////////////////////////////////////////////////////////////////////////
+
+std::string_view packet::httpRequest::getHeaderView(std::string_view hName) const
+{
+    auto search{this->headers.find(hName)};
+    if(search == this->headers.end())
+    {
+        return(std::string_view{});
+    }
+    return(search->second);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -262,6 +363,60 @@ int packet::httpRequest::getMinorVersion()
     return(this->versionMinor);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpRequest::getPathChoice
+///////////////////////////////////////////////////////////////////////////////
+
+bool packet::httpRequest::getPathChoice(const std::string& pName, size_t& pIndex)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // position of the matched value in the resource's setParameterChoices list
+    ///////////////////////////////////////////////////////////////////////////////
+
+    const pathValue *found{this->findPathValue(pName, enums::paramType::ENUMSET)};
+    if(found == nullptr)
+    {
+        return(false);
+    }
+    pIndex = static_cast<size_t>(found->number);
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpRequest::getPathHex
+///////////////////////////////////////////////////////////////////////////////
+
+bool packet::httpRequest::getPathHex(const std::string& pName, uint64_t& pValue)
+{
+    const pathValue *found{this->findPathValue(pName, enums::paramType::HEX)};
+    if(found == nullptr)
+    {
+        return(false);
+    }
+    pValue = found->bits;
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpRequest::getPathInt
+///////////////////////////////////////////////////////////////////////////////
+
+bool packet::httpRequest::getPathInt(const std::string& pName, int64_t& pValue)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // typed accessors only answer for parameters declared with that type;
+    // the value was validated and converted while routing
+    ///////////////////////////////////////////////////////////////////////////////
+
+    const pathValue *found{this->findPathValue(pName, enums::paramType::INT64)};
+    if(found == nullptr)
+    {
+        return(false);
+    }
+    pValue = found->number;
+    return(true);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpPacket::httpRequest::getPathParameter
 ///////////////////////////////////////////////////////////////////////////////
@@ -270,18 +425,34 @@ std::string packet::httpRequest::getPathParameter(const std::string& pName)
 {
     std::string returnString;
     
-    try
-    {
-        returnString = this->pathParameters.at(pName);
-    }
-    catch(const std::out_of_range& e)
+    for(const std::pair<std::string_view, std::string_view>& pathParameter : this->pathParameters)
     {
-        returnString.clear();
+        if(pathParameter.first == pName)
+        {
+            utility::parseUtilities parseUtil;
+            parseUtil.decodeSegment(pathParameter.second, returnString);
+            break;
+        }
     }
     
     return(std::move(returnString));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpRequest::getPathUUID
+///////////////////////////////////////////////////////////////////////////////
+
+bool packet::httpRequest::getPathUUID(const std::string& pName, std::array<uint8_t, 16>& pValue)
+{
+    const pathValue *found{this->findPathValue(pName, enums::paramType::UUID)};
+    if(found == nullptr)
+    {
+        return(false);
+    }
+    pValue = found->uuid;
+    return(true);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpPacket::httpRequest::getProtocol
 ///////////////////////////////////////////////////////////////////////////////
@@ -299,13 +470,10 @@ std::string packet::httpRequest::getQueryParameter(const std::string& pName)
 {
     std::string returnString;
     
-    try
-    {
-        returnString = this->queryParameters.at(pName);
-    }
-    catch(const std::out_of_range& e)
+    auto search{this->uriObj.parameters.find(pName)};
+    if(search != this->uriObj.parameters.end())
     {
-        returnString.clear();
+        returnString = search->second;
     }
     
     return(std::move(returnString));
@@ -333,7 +501,7 @@ std::string packet::httpRequest::getStatusReason()
 // frederick2::httpPacket::httpRequest::getURI
 ///////////////////////////////////////////////////////////////////////////////
 
-frederick2::httpServer::uri packet::httpRequest::getURI()
+const frederick2::httpServer::uri& packet::httpRequest::getURI() const
 {
     return(this->uriObj);
 }
@@ -347,6 +515,61 @@ bool packet::httpRequest::getHasContent()
     return(this->hasContent);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpRequest::recycle
+///////////////////////////////////////////////////////////////////////////////
+
+void packet::httpRequest::recycle()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // arena containers give up their storage before the arena is rewound.
+    // the response built on this arena must already have been recycled
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->cookies.clear();
+    this->headers.clear();
+    viewPairVECTOR(this->arena->getResource()).swap(this->pathParameters);
+    this->arena->rewind();
+    this->buffer = nullptr;
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpRequest::reset
+///////////////////////////////////////////////////////////////////////////////
+
+void packet::httpRequest::reset(std::string* inBuffer)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // back to the freshly constructed state.  strings are cleared, not
+    // released, so their capacity carries over to the next request
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->buffer = inBuffer;
+    this->memory = nullptr;
+    this->hasContent = false;
+    this->contentChunked = false;
+    this->versionMajor = 1;
+    this->versionMinor = 1;
+    this->contentReceived = 0;
+    this->contentLength = 0;
+    this->bytesReceived = 0;
+    this->pathValueCount = 0;
+    this->method = enums::httpMethod::OPTIONS;
+    this->protocol = enums::httpProtocol::HTTP;
+    this->requestStatus = enums::httpStatus::OK;
+    this->content.clear();
+    this->filePath.clear();
+    this->originalRequestLine.clear();
+    this->originalURIString.clear();
+    this->statusReason.clear();
+    this->cookies.clear();
+    this->headers.clear();
+    this->pathParameters.clear();
+    this->stageSeries.fill(0);
+    this->stages = stageClock{};
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpPacket::httpRequest::setMethod
 ///////////////////////////////////////////////////////////////////////////////
@@ -357,6 +580,22 @@ void packet::httpRequest::setMethod(enums::httpMethod inMethod)
     return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpRequest::takeContent
+///////////////////////////////////////////////////////////////////////////////
+
+std::string packet::httpRequest::takeContent()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // moves the body out so large uploads reach the handler without a copy.
+    // later getContent calls see an empty body
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string returnString{std::move(this->content)};
+    this->content.clear();
+    return(returnString);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpPacket::httpRequest::validateRequest
 ///////////////////////////////////////////////////////////////////////////////
@@ -373,7 +612,7 @@ enums::httpStatus packet::httpRequest::validateRequest()
     auto cLenSearch{this->headers.find("Content-Length")};
     if(cLenSearch != this->headers.end())
     {
-        this->contentLength = std::stoi(this->headers["Content-Length"]);
+        this->contentLength = std::stoi(std::string(cLenSearch->second));
         this->hasContent = true;
     }
             
@@ -386,5 +625,10 @@ enums::httpStatus packet::httpRequest::validateRequest()
 
 packet::httpRequest::~httpRequest()
 {
+    ///////////////////////////////////////////////////////////////////////////////
+    // arena is declared first so it is recycled after every container
+    // allocated from it has been destroyed
+    ///////////////////////////////////////////////////////////////////////////////
+
     this->buffer = nullptr;
 }
\ No newline at end of file
@@ -7,13 +7,23 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <charconv>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <utility>
 
 #include "../headers/frederick2_namespace.hpp"
 #include "../headers/http_response.hpp"
 #include "../headers/server_enum.hpp"
+#include "../headers/utility_compress.hpp"
+#include "../headers/utility_header.hpp"
 #include "../headers/utility_parse.hpp"
 
 namespace enums = frederick2::httpEnums;
@@ -29,7 +39,7 @@ namespace utility = frederick2::utility;
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// frederick2:: member definitions
+// frederick2::httpPacket::httpResponse member definitions
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -37,16 +47,18 @@ namespace utility = frederick2::utility;
 ///////////////////////////////////////////////////////////////////////////////
 
 packet::httpResponse::httpResponse()
+    : httpResponse(std::pmr::get_default_resource())
 {
-    this->versionMajor = 1;
-    this->versionMinor = 1;
-    this->contentChunks = 0;
-    this->contentLength = 0;
-    this->hasContent = false;
-    this->contentChunked = false;
-    this->protocol = enums::httpProtocol::HTTP;
-    this->requestMethod = enums::httpMethod::GET;
-    this->status = enums::httpStatus::OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+packet::httpResponse::httpResponse(std::pmr::memory_resource *arenaResource)
+{
+    this->contentFileDescriptor = -1;
+    this->reset(arenaResource);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -55,7 +67,14 @@ packet::httpResponse::httpResponse()
 
 void packet::httpResponse::addCookie(const std::string& cName, const std::string& cValue)
 {
-    this->cookies[cName] = cValue;
+    ///////////////////////////////////////////////////////////////////////////////
+    // each cookie gets its own Set-Cookie line (RFC6265 [3])
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string cookieValue{cName};
+    cookieValue.append("=");
+    cookieValue.append(cValue);
+    this->headers.append("Set-Cookie", cookieValue);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -64,96 +83,282 @@ void packet::httpResponse::addCookie(const std::string& cName, const std::string
 
 void packet::httpResponse::addHeader(const std::string& hName, const std::string& hValue)
 {
-    this->headers[hName] = hValue;
+    this->headers.set(hName, hValue);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// frederick2::httpPacket::httpResponse::getHasContent
+// frederick2::httpPacket::httpResponse::appendHeader
 ///////////////////////////////////////////////////////////////////////////////
 
-bool packet::httpResponse::getHasContent()
+void packet::httpResponse::appendHeader(const std::string& hName, const std::string& hValue)
 {
-    return(this->hasContent);
+    this->headers.append(hName, hValue);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// frederick2::httpPacket::httpResponse::getHeader
+// frederick2::httpPacket::httpResponse::appendContentString
 ///////////////////////////////////////////////////////////////////////////////
 
-std::string packet::httpResponse::getHeader(const std::string& hName)
+void packet::httpResponse::appendContentString(std::string& outString)
 {
-    std::string returnString;
-    
-    try
+    if(this->hasContent)
     {
-        returnString = this->headers.at(hName);
+        if(this->contentChunked)
+        {
+            for(size_t index = 0; index < this->chunks->size(); index++){
+                outString.append((*this->chunks)[index]);
+            }
+            outString.append("\r\n");
+        }
+        else
+        {
+            outString.append(this->content);
+        }        
     }
-    catch(const std::out_of_range& e)
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::appendHeaderLines
+///////////////////////////////////////////////////////////////////////////////
+
+void packet::httpResponse::appendHeaderLines(std::string& outString)
+{
+    this->headers.serialize(outString);
+    outString.append("\r\n");
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::appendStatusLine
+///////////////////////////////////////////////////////////////////////////////
+
+void packet::httpResponse::appendStatusLine(std::string& outString)
+{
+    char numberBuffer[16];
+    outString.append(enums::converter::protocol2str(this->protocol));
+    outString.append("/");
+    outString.append(numberBuffer, std::to_chars(numberBuffer, numberBuffer + sizeof(numberBuffer), this->versionMajor).ptr);
+    outString.append(".");
+    outString.append(numberBuffer, std::to_chars(numberBuffer, numberBuffer + sizeof(numberBuffer), this->versionMinor).ptr);
+    outString.append(" ");
+    outString.append(numberBuffer, std::to_chars(numberBuffer, numberBuffer + sizeof(numberBuffer), static_cast<int>(this->status)).ptr);
+    outString.append(" ");
+    outString.append(enums::converter::status2str(this->status));
+    outString.append("\r\n");
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::appendVary
+///////////////////////////////////////////////////////////////////////////////
+
+void packet::httpResponse::appendVary(const std::string& hName)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // Vary is a comma separated list of case-insensitive field names
+    // a "*" already varies on everything and is left alone (RFC7231 [7.1.4])
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string varyValue{this->getHeader("Vary")};
+    if(varyValue.size() == 0)
     {
-        returnString.clear();
+        this->addHeader("Vary", hName);
+        return;
     }
-    
-    return(std::move(returnString));
+
+    std::string_view remaining{varyValue};
+    while(remaining.size() > 0)
+    {
+        size_t commaPos{remaining.find(',')};
+        std::string_view token{remaining.substr(0, commaPos)};
+        remaining = (commaPos == std::string_view::npos) ? std::string_view{} : remaining.substr(commaPos + 1);
+        while(token.size() > 0 && (token.front() == ' ' || token.front() == '\t'))
+        {
+            token.remove_prefix(1);
+        }
+        while(token.size() > 0 && (token.back() == ' ' || token.back() == '\t'))
+        {
+            token.remove_suffix(1);
+        }
+        if(token == "*")
+        {
+            return;
+        }
+        if(token.size() != hName.size())
+        {
+            continue;
+        }
+        bool sameName{true};
+        for(size_t index = 0; index < token.size() && sameName; index++)
+        {
+            char tChar{token[index]};
+            char nChar{hName[index]};
+            if(tChar >= 'A' && tChar <= 'Z')
+            {
+                tChar |= 0x20;
+            }
+            if(nChar >= 'A' && nChar <= 'Z')
+            {
+                nChar |= 0x20;
+            }
+            sameName = (tChar == nChar);
+        }
+        if(sameName)
+        {
+            return;
+        }
+    }
+
+    varyValue.append(", ");
+    varyValue.append(hName);
+    this->addHeader("Vary", varyValue);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// frederick2::httpPacket::httpResponse::getHeaderLines
+// frederick2::httpPacket::httpResponse::compressEligible
 ///////////////////////////////////////////////////////////////////////////////
 
-std::string packet::httpResponse::getHeaderLines()
+bool packet::httpResponse::compressEligible(size_t bodySize)
 {
-    std::string newLine{"\r\n"};
-    std::string returnString;
-    
-    for(std::pair<std::string, std::string> element : this->headers)
+    ///////////////////////////////////////////////////////////////////////////////
+    // compression stage is enabled by the server through setCompression
+    // only uncoded 2xx content above the threshold with an allowed type qualifies
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->compressTypes == nullptr || this->contentCoding == enums::contentCoding::ENUMERROR)
+    {
+        return(false);
+    }
+    if(bodySize < this->compressThreshold || this->headers.has("Content-Encoding"))
     {
-	    returnString.append(element.first);
-        returnString.append(": ");
-        returnString.append(element.second);
-        returnString.append(newLine);
+        return(false);
+    }
+    int statusCode{static_cast<int>(this->status)};
+    if(statusCode < 200 || statusCode > 299 || statusCode == 204 || statusCode == 206)
+    {
+        return(false);
     }
 
-    for(std::pair<std::string, std::string> element : this->cookies)
+    utility::parseUtilities parseUtil;
+    std::string contentType;
+    parseUtil.toLower(this->getHeader("Content-Type"), contentType);
+    size_t semiFound{contentType.find_first_of(';')};
+    if(semiFound != std::string::npos)
     {
-        returnString.append("Set-Cookie: ");
-        returnString.append(element.first);
-        returnString.append("=");
-        returnString.append(element.second);
-        returnString.append(newLine);
+        contentType.erase(semiFound);
     }
+    size_t lastFound{contentType.find_last_not_of(" \t")};
+    contentType.erase(lastFound == std::string::npos ? 0 : lastFound + 1);
 
-    returnString.append(newLine);    
-    return(std::move(returnString));
+    for(const std::string& allowedType : *this->compressTypes)
+    {
+        size_t wildFound{allowedType.find("/*")};
+        if(allowedType == contentType)
+        {
+            return(true);
+        }
+        if(wildFound != std::string::npos && contentType.compare(0, wildFound + 1, allowedType, 0, wildFound + 1) == 0)
+        {
+            return(true);
+        }
+    }
+    return(false);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// frederick2::httpPacket::httpResponse::getStatus
+// frederick2::httpPacket::httpResponse::compressContent
 ///////////////////////////////////////////////////////////////////////////////
 
-enums::httpStatus packet::httpResponse::getStatus()
+bool packet::httpResponse::compressContent(strVECTOR& encodedBlocks)
 {
-    return(this->status);
+    if(!this->compressEligible(this->content.size()))
+    {
+        return(false);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // representation depends on Accept-Encoding even when sent as identity
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->appendVary("Accept-Encoding");
+    if(this->contentCoding == enums::contentCoding::IDENTITY)
+    {
+        return(false);
+    }
+
+    utility::compressor deflater(this->contentCoding);
+    if(!deflater.compress(this->content, encodedBlocks, 16384))
+    {
+        encodedBlocks.clear();
+        return(false);
+    }
+
+    std::string encodedContent;
+    for(const std::string& block : encodedBlocks)
+    {
+        encodedContent.append(block);
+    }
+    this->content = std::move(encodedContent);
+    
+    std::string codingName{utility::compressor::coding2str(this->contentCoding)};
+    this->addHeader("Content-Encoding", codingName);
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // strong validators must differ between representations
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string etag{this->getHeader("ETag")};
+    if(etag.size() > 1 && etag[0] == '\"' && etag[etag.size() - 1] == '\"')
+    {
+        etag.insert(etag.size() - 1, "-" + codingName);
+        this->addHeader("ETag", etag);
+    }
+
+    return(true);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// frederick2::httpPacket::httpResponse::getStatusLine
+// frederick2::httpPacket::httpResponse::getContentFile
 ///////////////////////////////////////////////////////////////////////////////
 
-std::string packet::httpResponse::getStatusLine()
+bool packet::httpResponse::getContentFile(int& fileDescriptor, size_t& fileLength)
 {
-    std::string newLine{"\r\n"};
-    std::string returnString;
-    returnString.append(enums::converter::protocol2str(this->protocol));
-    returnString.append("/");
-    returnString.append(std::to_string(this->versionMajor));
-    returnString.append(".");
-    returnString.append(std::to_string(this->versionMinor));
-    returnString.append(" ");
-    returnString.append(std::to_string((int)this->status));
-    returnString.append(" ");
-    returnString.append(enums::converter::status2str(this->status));
-    returnString.append(newLine);
-    return(std::move(returnString));
+    fileDescriptor = this->contentFileDescriptor;
+    fileLength = this->contentLength;
+    return(this->contentFileDescriptor >= 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::getHasContent
+///////////////////////////////////////////////////////////////////////////////
+
+bool packet::httpResponse::getHasContent()
+{
+    return(this->hasContent);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::getHeader
+///////////////////////////////////////////////////////////////////////////////
+
+std::string packet::httpResponse::getHeader(const std::string& hName)
+{
+    const std::string *found{this->headers.find(hName)};
+    if(found == nullptr)
+    {
+        return("");
+    }
+    return(*found);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::getStatus
+///////////////////////////////////////////////////////////////////////////////
+
+enums::httpStatus packet::httpResponse::getStatus()
+{
+    return(this->status);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -162,6 +367,37 @@ std::string packet::httpResponse::getStatusLine()
 
 void packet::httpResponse::handleContent()
 {
+    if(this->fromCache)
+    {
+        return;
+    }
+
+    if(this->contentFilePath.size() > 0)
+    {
+        if(!this->zeroCopy || !this->openContentFile())
+        {
+            this->loadContentFile();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // streamed file bodies are sent by the connection straight from the
+    // descriptor, only the length needs to be announced here
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->contentFileDescriptor >= 0)
+    {
+        this->contentChunked = false;
+        this->addHeader("Content-Length", std::to_string(this->contentLength));
+        if(this->requestMethod == enums::httpMethod::HEAD)
+        {
+            ::close(this->contentFileDescriptor);
+            this->contentFileDescriptor = -1;
+            this->hasContent = false;
+        }
+        return;
+    }
+
     if(!this->hasContent)
     {
         if(this->requestMethod == enums::httpMethod::CONNECT){
@@ -169,7 +405,7 @@ void packet::httpResponse::handleContent()
         }
 
         int statusCode{static_cast<int>(this->status)};
-        if(statusCode > 200 && statusCode != 204)
+        if(statusCode > 200 && statusCode != 204 && statusCode != 304)
         {
             this->addHeader("Content-Length", "0");
         }
@@ -177,45 +413,54 @@ void packet::httpResponse::handleContent()
         return;
     }
     
-    std::unique_ptr<utility::parseUtilities> parser{new utility::parseUtilities()};
-    this->chunks.clear();
+    ///////////////////////////////////////////////////////////////////////////////
+    // compressed output blocks double as the chunk boundaries
+    ///////////////////////////////////////////////////////////////////////////////
+
+    strVECTOR encodedBlocks;
+    this->compressContent(encodedBlocks);
+    
+    utility::parseUtilities parser;
+    this->chunks->clear();
     if(this->content.size() > 256)
     {
         this->contentChunked = true;
         std::string newLine{"\r\n"};
-        std::string workingContent{this->content};
         
         std::string chunk;
         size_t chunkSize{0};
-        std::string chunkContent;
+        size_t chunkOffset{0};
+        size_t blockIndex{0};
             
-        while(workingContent.size() > 0)
+        while(chunkOffset < this->content.size())
         {
-            if(workingContent.size() > 256)
+            if(encodedBlocks.size() > 0)
+            {
+                chunkSize = encodedBlocks[blockIndex].size();
+                blockIndex++;
+            }
+            else if(this->content.size() - chunkOffset > 256)
             {
                 chunkSize = 256;
-                chunkContent = workingContent.substr(0, chunkSize);
-                workingContent.erase(0, chunkSize);
             }
             else
             {
-                chunkSize = workingContent.size();
-                chunkContent = workingContent;
-                workingContent.clear();
+                chunkSize = this->content.size() - chunkOffset;
             }
             chunk.clear();
-            parser->toHex(chunkSize, chunk);
+            parser.toHex(chunkSize, chunk);
             chunk.append(newLine);
-            chunk.append(chunkContent);
+            chunk.append(this->content, chunkOffset, chunkSize);
             chunk.append(newLine);
-            this->chunks.push_back(chunk);            
+            this->chunks->emplace_back(std::string_view{chunk});
+            chunkOffset += chunkSize;
         }
 
         chunk.clear();
         chunkSize = 0;
-        parser->toHex(chunkSize, chunk);
+        parser.toHex(chunkSize, chunk);
         chunk.append(newLine);
-        this->chunks.push_back(chunk);
+        this->chunks->emplace_back(std::string_view{chunk});
         this->addHeader("Transfer-Encoding", "chunked");
     }
     else
@@ -228,7 +473,7 @@ void packet::httpResponse::handleContent()
     if(this->requestMethod == enums::httpMethod::HEAD)
     {
         this->content.clear();
-        this->chunks.clear();
+        this->chunks->clear();
         this->contentChunked = false;
         this->hasContent = false;
     }
@@ -236,6 +481,183 @@ void packet::httpResponse::handleContent()
     return;    
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::loadContentFile
+///////////////////////////////////////////////////////////////////////////////
+
+bool packet::httpResponse::loadContentFile()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // serve a precompressed "<file>.gz" sibling when the client accepts gzip
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->compressTypes != nullptr)
+    {
+        std::ifstream gzipFile(this->contentFilePath + ".gz", std::ios::in | std::ios::binary);
+        if(gzipFile.is_open())
+        {
+            this->appendVary("Accept-Encoding");
+            if(this->contentCoding == enums::contentCoding::GZIP)
+            {
+                this->content.assign(std::istreambuf_iterator<char>(gzipFile), std::istreambuf_iterator<char>());
+                this->hasContent = true;
+                this->addHeader("Content-Encoding", "gzip");
+                return(true);
+            }
+        }
+    }
+
+    std::ifstream plainFile(this->contentFilePath, std::ios::in | std::ios::binary);
+    if(!plainFile.is_open())
+    {
+        return(false);
+    }
+    this->content.assign(std::istreambuf_iterator<char>(plainFile), std::istreambuf_iterator<char>());
+    this->hasContent = true;
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::openContentFile
+///////////////////////////////////////////////////////////////////////////////
+
+bool packet::httpResponse::openContentFile()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // keep the file on disk so the connection can sendfile it.  bodies that
+    // still need on the fly compression fall back to loadContentFile
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string targetPath{this->contentFilePath};
+    bool gzipSibling{false};
+    if(this->compressTypes != nullptr)
+    {
+        std::string gzipPath{this->contentFilePath + ".gz"};
+        if(::access(gzipPath.c_str(), R_OK) == 0)
+        {
+            this->appendVary("Accept-Encoding");
+            if(this->contentCoding == enums::contentCoding::GZIP)
+            {
+                targetPath = gzipPath;
+                gzipSibling = true;
+            }
+        }
+    }
+
+    int fileDescriptor{::open(targetPath.c_str(), O_RDONLY | O_CLOEXEC)};
+    if(fileDescriptor < 0)
+    {
+        return(false);
+    }
+    struct stat fileStat;
+    if(::fstat(fileDescriptor, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+    {
+        ::close(fileDescriptor);
+        return(false);
+    }
+
+    if(!gzipSibling && this->compressEligible(fileStat.st_size))
+    {
+        this->appendVary("Accept-Encoding");
+        if(this->contentCoding == enums::contentCoding::GZIP || this->contentCoding == enums::contentCoding::DEFLATE)
+        {
+            ::close(fileDescriptor);
+            return(false);
+        }
+    }
+
+    if(gzipSibling)
+    {
+        this->addHeader("Content-Encoding", "gzip");
+    }
+    this->contentFileDescriptor = fileDescriptor;
+    this->contentLength = fileStat.st_size;
+    this->hasContent = true;
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::recycle
+///////////////////////////////////////////////////////////////////////////////
+
+void packet::httpResponse::recycle()
+{
+    if(this->contentFileDescriptor >= 0)
+    {
+        ::close(this->contentFileDescriptor);
+        this->contentFileDescriptor = -1;
+    }
+    this->chunks.reset();
+    this->cachedPayload.reset();
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::reset
+///////////////////////////////////////////////////////////////////////////////
+
+void packet::httpResponse::reset(std::pmr::memory_resource *arenaResource)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // header strings and content keep their capacity.  chunks are rebuilt
+    // on the new arena since a pmr vector cannot change its resource
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->contentFileDescriptor >= 0)
+    {
+        ::close(this->contentFileDescriptor);
+    }
+    this->versionMajor = 1;
+    this->versionMinor = 1;
+    this->contentChunks = 0;
+    this->contentLength = 0;
+    this->cachedHeadLength = 0;
+    this->compressThreshold = 0;
+    this->compressTypes = nullptr;
+    this->contentCoding = enums::contentCoding::IDENTITY;
+    this->contentFileDescriptor = -1;
+    this->hasContent = false;
+    this->contentChunked = false;
+    this->fromCache = false;
+    this->zeroCopy = false;
+    this->protocol = enums::httpProtocol::HTTP;
+    this->requestMethod = enums::httpMethod::GET;
+    this->status = enums::httpStatus::OK;
+    this->content.clear();
+    this->contentFilePath.clear();
+    this->statusReason.clear();
+    this->cachedPayload.reset();
+    this->headers.clear();
+    this->chunks.emplace(arenaResource);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::setCachedPayload
+///////////////////////////////////////////////////////////////////////////////
+
+void packet::httpResponse::setCachedPayload(std::shared_ptr<const std::string> payload, size_t headLength)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // payload holds the status line and headers (minus Connection) followed
+    // by the serialized body.  headLength marks where the body begins
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->cachedPayload = std::move(payload);
+    this->cachedHeadLength = headLength;
+    this->fromCache = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::setCompression
+///////////////////////////////////////////////////////////////////////////////
+
+void packet::httpResponse::setCompression(enums::contentCoding acceptCoding, size_t threshold, const strVECTOR *allowedTypes)
+{
+    this->contentCoding = acceptCoding;
+    this->compressThreshold = threshold;
+    this->compressTypes = allowedTypes;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpPacket::httpResponse::setContent
 ///////////////////////////////////////////////////////////////////////////////
@@ -246,6 +668,26 @@ void packet::httpResponse::setContent(const std::string& newContent)
     this->hasContent = true;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::setContentFile
+///////////////////////////////////////////////////////////////////////////////
+
+bool packet::httpResponse::setContentFile(const std::string& filePath)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // file is read when content is handled so a precompressed sibling
+    // can be chosen once the negotiated coding is known
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::ifstream targetFile(filePath, std::ios::in | std::ios::binary);
+    if(!targetFile.is_open())
+    {
+        return(false);
+    }
+    this->contentFilePath = filePath;
+    return(true);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpPacket::httpResponse::setMajorVersion
 ///////////////////////////////////////////////////////////////////////////////
@@ -300,32 +742,87 @@ void packet::httpResponse::setStatusReason(const std::string& reason)
     this->statusReason = reason;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::setZeroCopy
+///////////////////////////////////////////////////////////////////////////////
+
+void packet::httpResponse::setZeroCopy(bool zeroCopyFlag)
+{
+    this->zeroCopy = zeroCopyFlag;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpPacket::httpResponse::toCacheString
+///////////////////////////////////////////////////////////////////////////////
+
+std::string packet::httpResponse::toCacheString(size_t& headLength, const std::vector<std::string>& skipNames)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // status line and header lines without the blank line that ends the header
+    // so per-request headers can be appended when served from cache.
+    // skipNames are headers middleware sets again on every request.
+    // Server is settled here, Date is always added fresh when served
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::vector<std::string> cacheSkipNames{skipNames};
+    cacheSkipNames.push_back("Date");
+
+    std::string returnString;
+    returnString.reserve(this->headers.serializedSize() + this->content.size() + 128);
+    this->appendStatusLine(returnString);
+    utility::headerCache::appendCommonHeaders(returnString, !this->headers.has("Server"), false);
+    this->headers.serialize(returnString, cacheSkipNames);
+    headLength = returnString.size();
+    this->appendContentString(returnString);
+    return(std::move(returnString));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpPacket::httpResponse::toString
 ///////////////////////////////////////////////////////////////////////////////
 
 std::string packet::httpResponse::toString()
 {
+    ///////////////////////////////////////////////////////////////////////////////
+    // Server and Date come from the per-thread pre-serialized block rather
+    // than the header map, so cached heads never carry a stale Date.
+    // a handler's own Server or Date replaces the block's field
+    // every part is appended straight into the reserved result
+    ///////////////////////////////////////////////////////////////////////////////
+
     std::string returnString;
-    returnString.append(this->getStatusLine());
-    returnString.append(this->getHeaderLines());
 
+    if(this->fromCache)
+    {
+        returnString.reserve(this->cachedPayload->size() + this->headers.serializedSize() + 128);
+        returnString.append(*this->cachedPayload, 0, this->cachedHeadLength);
+        utility::headerCache::appendCommonHeaders(returnString, false, !this->headers.has("Date"));
+        this->appendHeaderLines(returnString);
+        if(this->requestMethod != enums::httpMethod::HEAD)
+        {
+            returnString.append(*this->cachedPayload, this->cachedHeadLength, std::string::npos);
+        }
+        return(std::move(returnString));
+    }
+
+    size_t contentSize{0};
     if(this->hasContent)
     {
+        contentSize = this->content.size() + 2;
         if(this->contentChunked)
         {
-            std::string newLine{"\r\n"};
-            for(size_t index = 0; index < this->chunks.size(); index++){
-                returnString.append(this->chunks[index]);
+            contentSize = 2;
+            for(const std::pmr::string& chunk : *this->chunks)
+            {
+                contentSize += chunk.size();
             }
-            returnString.append(newLine);
         }
-        else
-        {
-            returnString.append(this->content);
-        }        
     }
-    
+    returnString.reserve(this->headers.serializedSize() + contentSize + 128);
+    this->appendStatusLine(returnString);
+    utility::headerCache::appendCommonHeaders(returnString, !this->headers.has("Server"), !this->headers.has("Date"));
+    this->appendHeaderLines(returnString);
+    this->appendContentString(returnString);
     return(std::move(returnString));
 }
 
@@ -335,5 +832,9 @@ std::string packet::httpResponse::toString()
 
 packet::httpResponse::~httpResponse()
 {
-
+    if(this->contentFileDescriptor >= 0)
+    {
+        ::close(this->contentFileDescriptor);
+        this->contentFileDescriptor = -1;
+    }
 }
\ No newline at end of file
@@ -52,7 +52,7 @@ packet::contentParser::contentParser(std::string *inBuffer)
 
 enums::httpStatus packet::contentParser::executeChunked()
 {
-    std::unique_ptr<utility::bufferStringReader> buffReader{new utility::bufferStringReader(this->buffer)};
+    utility::bufferStringReader buffReader{this->buffer};
     enums::httpStatus returnStatus{enums::httpStatus::OK};
     bool lastChunkReached{false};
     size_t bytesRead{0};
@@ -77,10 +77,10 @@ enums::httpStatus packet::contentParser::executeChunked()
             
             std::string chunkData;            
 
-            returnStatus = buffReader->extractFixedSize(chunkLength, chunkData, bytesRead, 30);
+            returnStatus = buffReader.extractFixedSize(chunkLength, chunkData, bytesRead, 30);
             if(returnStatus != enums::httpStatus::OK)
             {
-                this->statusReason = buffReader->getStatusReason();
+                this->statusReason = buffReader.getStatusReason();
                 return(returnStatus);
             }
             else
@@ -94,10 +94,10 @@ enums::httpStatus packet::contentParser::executeChunked()
             // append chunkdata to total content
             ///////////////////////////////////////////////////////////////////////////////
             
-            returnStatus = buffReader->extractLeadingEOL(bytesRead);
+            returnStatus = buffReader.extractLeadingEOL(bytesRead);
             if(returnStatus != enums::httpStatus::OK)
             {
-                this->statusReason = buffReader->getStatusReason();
+                this->statusReason = buffReader.getStatusReason();
                 return(returnStatus);
             }
             else
@@ -126,10 +126,10 @@ enums::httpStatus packet::contentParser::executeChunked()
     while(endlFound != 0)
     {
         std::string trailerPart;
-        returnStatus = buffReader->extractSingleLine(trailerPart, bytesRead, 8192, 30);
+        returnStatus = buffReader.extractSingleLine(trailerPart, bytesRead, 8192, 30);
         if(returnStatus != enums::httpStatus::OK)
         {
-            this->statusReason = buffReader->getStatusReason();
+            this->statusReason = buffReader.getStatusReason();
             return(returnStatus);
         }
         else
@@ -146,10 +146,10 @@ enums::httpStatus packet::contentParser::executeChunked()
     // extract trainling CRLF
     ///////////////////////////////////////////////////////////////////////////////
     
-    returnStatus = buffReader->extractLeadingEOL(bytesRead);
+    returnStatus = buffReader.extractLeadingEOL(bytesRead);
     if(returnStatus != enums::httpStatus::OK)
     {
-        this->statusReason = buffReader->getStatusReason();
+        this->statusReason = buffReader.getStatusReason();
         return(returnStatus);
     }
     else
@@ -166,17 +166,17 @@ enums::httpStatus packet::contentParser::executeChunked()
 
 enums::httpStatus packet::contentParser::executeContinuous(const size_t& contentLength)
 {
-    std::unique_ptr<utility::bufferStringReader> buffReader{new utility::bufferStringReader(this->buffer)};
+    utility::bufferStringReader buffReader{this->buffer};
     enums::httpStatus returnStatus{enums::httpStatus::OK};
     
     this->contentLength = contentLength;
     std::string bodyData;
     size_t bytesRead{0};
 
-    returnStatus = buffReader->extractFixedSize(contentLength, bodyData, bytesRead, 30);
+    returnStatus = buffReader.extractFixedSize(contentLength, bodyData, bytesRead, 30);
     if(returnStatus != enums::httpStatus::OK)
     {
-        this->statusReason = buffReader->getStatusReason();
+        this->statusReason = buffReader.getStatusReason();
         return(returnStatus);
     }
     else
@@ -276,17 +276,17 @@ std::string packet::contentParser::getStatusReason()
 
 enums::httpStatus packet::contentParser::parseChunkHeader(size_t& chunkLength, strMAPstr& extensionMap)
 {
-    std::unique_ptr<utility::bufferStringReader> buffReader{new utility::bufferStringReader(this->buffer)};
-    std::unique_ptr<utility::parseUtilities> parseUtil{new utility::parseUtilities()};
+    utility::bufferStringReader buffReader{this->buffer};
+    utility::parseUtilities parseUtil;
     enums::httpStatus returnStatus{enums::httpStatus::OK};
     
     std::string workingLine;
     size_t bytesRead{0};
     
-    returnStatus = buffReader->extractSingleLine(workingLine, bytesRead, 8192, 30);
+    returnStatus = buffReader.extractSingleLine(workingLine, bytesRead, 8192, 30);
     if(returnStatus != enums::httpStatus::OK)
     {
-        this->statusReason = buffReader->getStatusReason();
+        this->statusReason = buffReader.getStatusReason();
         return(returnStatus);
     }
     else
@@ -339,11 +339,11 @@ enums::httpStatus packet::contentParser::parseChunkHeader(size_t& chunkLength, s
             eNameInit = extensionStr;
         }
         
-        parseUtil->toLower(eNameInit, eNameFinal);
+        parseUtil.toLower(eNameInit, eNameFinal);
         size_t dqFound{eValueInit.find_first_of('\"')};
         if(dqFound != std::string::npos)
         {
-            if(!parseUtil->dqExtract(eValueInit, eValueFinal, true))
+            if(!parseUtil.dqExtract(eValueInit, eValueFinal, true))
             {
                 this->statusReason = "Invalid characters in chunk extension";
                 return(enums::httpStatus::BAD_REQUEST);
@@ -351,7 +351,7 @@ enums::httpStatus packet::contentParser::parseChunkHeader(size_t& chunkLength, s
         }
         else
         {
-            parseUtil->toLower(eValueInit, eValueFinal);
+            parseUtil.toLower(eValueInit, eValueFinal);
         }
 
         extensionMap.insert({eNameFinal, eValueFinal});
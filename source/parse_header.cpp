@@ -9,7 +9,9 @@
 
 #include <exception>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 #include "../headers/frederick2_namespace.hpp"
 #include "../headers/parse_header.hpp"
@@ -39,8 +41,13 @@ namespace server = frederick2::httpServer;
 // Constructor
 ///////////////////////////////////////////////////////////////////////////////
 
-packet::headerParser::headerParser(std::string *inBuffer)
+packet::headerParser::headerParser(std::string *inBuffer, std::pmr::memory_resource *arenaResource)
+    : cookies{arenaResource}, headers{arenaResource}
 {
+    ///////////////////////////////////////////////////////////////////////////////
+    // maps are built in the request's arena so handing them over is a move
+    ///////////////////////////////////////////////////////////////////////////////
+
     this->buffer = inBuffer;
     this->bytesReceived = 0;
 
@@ -58,26 +65,26 @@ enums::httpStatus packet::headerParser::execute()
 {
     enums::httpStatus headerStatus{enums::httpStatus::OK};
     
-    std::unique_ptr<packet::requestLineParser> reqLineParser{new packet::requestLineParser(this->buffer)};    
-    headerStatus = reqLineParser->execute();
+    packet::requestLineParser reqLineParser{this->buffer};
+    headerStatus = reqLineParser.execute();
     switch(headerStatus)
     {
         case enums::httpStatus::OK:
-            this->method = reqLineParser->getMethod();
-            this->protocol = reqLineParser->getProtocol();
-            this->versionMajor = reqLineParser->getMajorVersion();
-            this->versionMinor = reqLineParser->getMinorVersion();
-            this->uriObj = reqLineParser->getURI();
-            this->originalURIString = reqLineParser->getURIString();
-            this->originalRequestLine = reqLineParser->getRequestLineString();
-            this->bytesReceived += reqLineParser->getBytesReceived();
+            this->method = reqLineParser.getMethod();
+            this->protocol = reqLineParser.getProtocol();
+            this->versionMajor = reqLineParser.getMajorVersion();
+            this->versionMinor = reqLineParser.getMinorVersion();
+            this->uriObj = reqLineParser.getURI();
+            this->originalURIString = reqLineParser.getURIString();
+            this->originalRequestLine = reqLineParser.getRequestLineString();
+            this->bytesReceived += reqLineParser.getBytesReceived();
             break;
         case enums::httpStatus::BAD_REQUEST:
             [[fallthrough]];
         case enums::httpStatus::NOT_IMPLEMENTED:
             [[fallthrough]];
         case enums::httpStatus::REQUEST_TIMEOUT:
-            this->statusReason = reqLineParser->getStatusReason();
+            this->statusReason = reqLineParser.getStatusReason();
             return(headerStatus);
         default:
             this->statusReason = "Invalid return from reqLineParser";
@@ -85,19 +92,16 @@ enums::httpStatus packet::headerParser::execute()
     }
 
     size_t endlFound{this->buffer->find("\r\n")};
+    packet::headerLineParser headLineParser{this->buffer};
     while(endlFound != 0)
     {
-        std::unique_ptr<packet::headerLineParser > headLineParser{new packet::headerLineParser(this->buffer)};
-        headerStatus = headLineParser->execute();
+        headerStatus = headLineParser.execute();
         switch(headerStatus)
         {
             case enums::httpStatus::OK:
             {
-                std::string fieldName = headLineParser->getFieldName();
-                std::string originalValueString = headLineParser->getFieldValueString();
-                std::string originalHeaderLine = headLineParser->getHeaderLineString();
-                this->bytesReceived += headLineParser->getBytesReceived();
-                headerStatus = this->handleNewHeaderField(fieldName, originalValueString);
+                this->bytesReceived += headLineParser.getBytesReceived();
+                headerStatus = this->handleNewHeaderField(headLineParser.getFieldName(), headLineParser.getFieldValueString());
                 if(headerStatus != enums::httpStatus::OK)
                 {
                     return(headerStatus);
@@ -107,7 +111,7 @@ enums::httpStatus packet::headerParser::execute()
             case enums::httpStatus::BAD_REQUEST:
                 [[fallthrough]];
             case enums::httpStatus::REQUEST_TIMEOUT:
-                this->statusReason = headLineParser->getStatusReason();
+                this->statusReason = headLineParser.getStatusReason();
                 return(headerStatus);
             default:
                 this->statusReason = "Invalid return from headLineParser";
@@ -138,7 +142,7 @@ size_t packet::headerParser::getBytesReceived()
 // frederick2::httpRequest::headerParser::getCookies
 ///////////////////////////////////////////////////////////////////////////////
 
-strMAPstr packet::headerParser::getCookies()
+pmrMAPstr packet::headerParser::getCookies()
 {
     return(std::move(this->cookies));
 }
@@ -147,7 +151,7 @@ strMAPstr packet::headerParser::getCookies()
 // frederick2::httpRequest::headerParser::getHeaders
 ///////////////////////////////////////////////////////////////////////////////
 
-strMAPstr packet::headerParser::getHeaders()
+pmrMAPstr packet::headerParser::getHeaders()
 {
     return(std::move(this->headers));
 }
@@ -241,7 +245,7 @@ enums::httpStatus packet::headerParser::handleNewHeaderField(const std::string&
             switch(returnStatus)
             {
                 case enums::httpStatus::OK:
-                    this->headers["Cookie"] = "true";
+                    this->headers.emplace("Cookie", "true");
                     break;
                 case enums::httpStatus::BAD_REQUEST:
                     return(returnStatus);
@@ -263,14 +267,12 @@ enums::httpStatus packet::headerParser::handleNewHeaderField(const std::string&
     auto search = this->headers.find(name);
     if(search == this->headers.end())
     {
-        this->headers[name] = value;                
+        this->headers.emplace(std::string_view{name}, std::string_view{value});
     }
     else
     {
-        std::string newValue{this->headers[name]}; 
-        newValue.append(",");
-        newValue.append(value);
-        this->headers[name] = newValue;
+        search->second.append(",");
+        search->second.append(value);
     }
 
     return(returnStatus);
@@ -282,10 +284,10 @@ enums::httpStatus packet::headerParser::handleNewHeaderField(const std::string&
 
 enums::httpStatus packet::headerParser::parseCookie(const std::string& cValue)
 {
-    std::unique_ptr<utility::parseUtilities> parseUtil{new utility::parseUtilities()};
+    utility::parseUtilities parseUtil;
     std::string workingStr;
 
-    if(!parseUtil->pctDecode(cValue, workingStr))
+    if(!parseUtil.pctDecode(cValue, workingStr))
     {
         this->statusReason = "Disallowed characters in cookie string";
         return(enums::httpStatus::BAD_REQUEST);
@@ -317,11 +319,11 @@ enums::httpStatus packet::headerParser::parseCookie(const std::string& cValue)
             std::string cookieValueFinal;
             std::string cookieNameInit{cookiePair.substr(0, eqFound)};
             std::string cookieValueInit{cookiePair.substr(eqFound + 1)};
-            parseUtil->toLower(cookieNameInit, cookieNameFinal);
+            parseUtil.toLower(cookieNameInit, cookieNameFinal);
             size_t dqueFound{cookieValueInit.find_first_of('\"')};
             if(dqueFound != std::string::npos)
             {
-                if(!parseUtil->dqExtract(cookieValueInit, cookieValueFinal, true))
+                if(!parseUtil.dqExtract(cookieValueInit, cookieValueFinal, true))
                 {
                     this->statusReason = "Disallowed characters in cookie string";
                     return(enums::httpStatus::BAD_REQUEST);
@@ -329,9 +331,9 @@ enums::httpStatus packet::headerParser::parseCookie(const std::string& cValue)
             }
             else
             {
-                parseUtil->toLower(cookieValueInit, cookieValueFinal);
+                parseUtil.toLower(cookieValueInit, cookieValueFinal);
             }
-            this->cookies.insert({cookieNameFinal, cookieValueFinal});            
+            this->cookies.emplace(std::string_view{cookieNameFinal}, std::string_view{cookieValueFinal});
         }
     }
 
@@ -11,6 +11,7 @@
 #include <exception>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "../headers/frederick2_namespace.hpp"
 #include "../headers/parse_header_line.hpp"
@@ -25,6 +26,8 @@ namespace utility = frederick2::utility;
 // global variable definitions
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+static constexpr const char *wspChars{" \f\n\r\t\v"};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // global function definitions
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -49,25 +52,28 @@ packet::headerLineParser::headerLineParser(std::string *inBuffer)
 
 enums::httpStatus packet::headerLineParser::execute()
 {
-    std::unique_ptr<utility::bufferStringReader> buffReader{new utility::bufferStringReader(this->buffer)};
+    ///////////////////////////////////////////////////////////////////////////////
+    // the parser is reused for every line of a header block, so the line
+    // is read straight into originalHeaderLine and split through a view;
+    // the member strings keep their capacity from line to line
+    ///////////////////////////////////////////////////////////////////////////////
+
+    utility::bufferStringReader buffReader{this->buffer};
     enums::httpStatus returnStatus{enums::httpStatus::OK};
-    std::string wspCharsStr{" \f\n\r\t\v"};
-    const char *wspChars{wspCharsStr.c_str()};
-    
-    std::string workingLine;
     size_t bytesRead{0};
+    this->bytesReceived = 0;
     
-    returnStatus = buffReader->extractSingleLine(workingLine, bytesRead, 8192, 30);
+    returnStatus = buffReader.extractSingleLine(this->originalHeaderLine, bytesRead, 8192, 30);
     if(returnStatus != enums::httpStatus::OK)
     {
-        this->statusReason = buffReader->getStatusReason();
+        this->statusReason = buffReader.getStatusReason();
         return(returnStatus);
     }
     else
     {
         this->bytesReceived += bytesRead;
-        this->originalHeaderLine = workingLine;
     }
+    std::string_view workingLine{this->originalHeaderLine};
     
     ///////////////////////////////////////////////////////////////////////////////
     // Find first occurance of whitespace
@@ -85,19 +91,19 @@ enums::httpStatus packet::headerLineParser::execute()
         this->statusReason = "Invalid whitespace at start of header line (RFC7230 [3.2.4])";
         return(enums::httpStatus::BAD_REQUEST);
     }
-    if(colFound == std::string::npos)
+    if(colFound == std::string_view::npos)
     {
         this->statusReason = "Invalid header line. No divider between name:value pair. (RFC7230 [3.2])";
         return(enums::httpStatus::BAD_REQUEST);
     }
-    if(wspFound != std::string::npos && wspFound < colFound)
+    if(wspFound != std::string_view::npos && wspFound < colFound)
     {
         this->statusReason = "Invalid whitespace before divider between name:value pair. (RFC7230 [3.2.4])";
         return(enums::httpStatus::BAD_REQUEST);
     }
 
-    this->fieldName = workingLine.substr(0, colFound);
-    workingLine.erase(0, colFound + 1);
+    this->fieldName.assign(workingLine.substr(0, colFound));
+    workingLine.remove_prefix(colFound + 1);
 
     ///////////////////////////////////////////////////////////////////////////////
     // find first non whitespace character in remaining workingLine
@@ -107,7 +113,7 @@ enums::httpStatus packet::headerLineParser::execute()
                     
     size_t nonWspFoundFirst = workingLine.find_first_not_of(wspChars);
     size_t nonWspFoundLast = workingLine.find_last_not_of(wspChars);
-    if(nonWspFoundFirst == std::string::npos)
+    if(nonWspFoundFirst == std::string_view::npos)
     {
         ///////////////////////////////////////////////////////////////////////////////
         // no non-whitepsace charcters found in remaining headerLine
@@ -121,7 +127,7 @@ enums::httpStatus packet::headerLineParser::execute()
     else
     {
         size_t valueLength = (nonWspFoundLast - nonWspFoundFirst) + 1;
-        this->originalValueString = workingLine.substr(nonWspFoundFirst, valueLength);
+        this->originalValueString.assign(workingLine.substr(nonWspFoundFirst, valueLength));
     }
     
     ///////////////////////////////////////////////////////////////////////////////
@@ -148,7 +154,7 @@ size_t packet::headerLineParser::getBytesReceived()
 // frederick2::httpRequest::headerLineParser::getFieldName
 ///////////////////////////////////////////////////////////////////////////////
 
-std::string packet::headerLineParser::getFieldName()
+const std::string& packet::headerLineParser::getFieldName()
 {
     return(this->fieldName);
 }
@@ -157,7 +163,7 @@ std::string packet::headerLineParser::getFieldName()
 // frederick2::httpRequest::headerLineParser::getFieldValueString
 ///////////////////////////////////////////////////////////////////////////////
 
-std::string packet::headerLineParser::getFieldValueString()
+const std::string& packet::headerLineParser::getFieldValueString()
 {
     return(this->originalValueString);
 }
@@ -166,7 +172,7 @@ std::string packet::headerLineParser::getFieldValueString()
 // frederick2::httpRequest::headerLineParser::getHeaderLineString
 ///////////////////////////////////////////////////////////////////////////////
 
-std::string packet::headerLineParser::getHeaderLineString()
+const std::string& packet::headerLineParser::getHeaderLineString()
 {
     return(this->originalHeaderLine);
 }
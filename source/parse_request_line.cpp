@@ -26,6 +26,8 @@ namespace utility = frederick2::utility;
 // global variable definitions
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+static constexpr const char *wspChars{" \f\n\r\t\v"};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // global function definitions
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -44,7 +46,6 @@ packet::requestLineParser::requestLineParser(std::string* inBuffer)
     this->bytesReceived = 0;
     this->versionMajor = -1;
     this->versionMinor = -1;
-    this->statusReason = "No execution occurred";
     this->method = enums::httpMethod::OPTIONS;
     this->protocol = enums::httpProtocol::HTTP;
 }
@@ -56,9 +57,7 @@ packet::requestLineParser::requestLineParser(std::string* inBuffer)
 enums::httpStatus packet::requestLineParser::execute()
 {
     enums::httpStatus requestStatus{enums::httpStatus::OK};
-    std::unique_ptr<utility::bufferStringReader> buffReader{new utility::bufferStringReader(this->buffer)};
-    std::string wspCharsStr{" \f\n\r\t\v"};
-    const char *wspChars{wspCharsStr.c_str()};
+    utility::bufferStringReader buffReader{this->buffer};
     
     std::string workingLine;
     size_t bytesRead{0};
@@ -68,9 +67,9 @@ enums::httpStatus packet::requestLineParser::execute()
     // (RFC 7230 [3.5])
     ///////////////////////////////////////////////////////////////////////////////
     
-    requestStatus = buffReader->extractLeadingEOL(bytesRead);
+    requestStatus = buffReader.extractLeadingEOL(bytesRead);
     if(requestStatus != enums::httpStatus::OK){
-        this->statusReason = buffReader->getStatusReason();
+        this->statusReason = buffReader.getStatusReason();
         return(requestStatus);
     }
     else
@@ -83,9 +82,9 @@ enums::httpStatus packet::requestLineParser::execute()
     // Max line size = 8192, Timeout = 30s
     ///////////////////////////////////////////////////////////////////////////////
     
-    requestStatus = buffReader->extractSingleLine(workingLine, bytesRead, 8192, 30);
+    requestStatus = buffReader.extractSingleLine(workingLine, bytesRead, 8192, 30);
     if(requestStatus != enums::httpStatus::OK){
-        this->statusReason = buffReader->getStatusReason();
+        this->statusReason = buffReader.getStatusReason();
         return(requestStatus);
     }
     else
@@ -133,9 +132,6 @@ enums::httpStatus packet::requestLineParser::execute()
 
 enums::httpStatus packet::requestLineParser::extractMajorVersion(std::string& workingLine)
 {
-    std::string wspCharsStr{" \f\n\r\t\v"};
-    const char *wspChars{wspCharsStr.c_str()};
-
     ///////////////////////////////////////////////////////////////////////////////
     // Find first occurance of '.'
     // If whitepace occurs before '.', return Bad Request
@@ -175,9 +171,6 @@ enums::httpStatus packet::requestLineParser::extractMajorVersion(std::string& wo
 
 enums::httpStatus packet::requestLineParser::extractMethod(std::string& workingLine)
 {
-    std::string wspCharsStr{" \f\n\r\t\v"};
-    const char *wspChars{wspCharsStr.c_str()};
-
     ///////////////////////////////////////////////////////////////////////////////
     // Find first occurance of whitespace
     // If at front, return Bad Request
@@ -215,9 +208,6 @@ enums::httpStatus packet::requestLineParser::extractMethod(std::string& workingL
 
 enums::httpStatus packet::requestLineParser::extractMinorVersion(std::string& workingLine)
 {
-    std::string wspCharsStr{" \f\n\r\t\v"};
-    const char *wspChars{wspCharsStr.c_str()};
-
     ///////////////////////////////////////////////////////////////////////////////
     // Find first occurance of whitespace
     // If found, return Bad Request
@@ -252,9 +242,6 @@ enums::httpStatus packet::requestLineParser::extractMinorVersion(std::string& wo
 
 enums::httpStatus packet::requestLineParser::extractProtocol(std::string& workingLine)
 {
-    std::string wspCharsStr{" \f\n\r\t\v"};
-    const char *wspChars{wspCharsStr.c_str()};
-
     ///////////////////////////////////////////////////////////////////////////////
     // Find first occurance of whitespace
     // If at front, return Bad Request
@@ -303,9 +290,6 @@ enums::httpStatus packet::requestLineParser::extractProtocol(std::string& workin
 
 enums::httpStatus packet::requestLineParser::extractURI(std::string& workingLine)
 {
-    std::string wspCharsStr{" \f\n\r\t\v"};
-    const char *wspChars{wspCharsStr.c_str()};
-
     ///////////////////////////////////////////////////////////////////////////////
     // Find first occurance of whitespace
     // If at front, return Bad Request
@@ -382,7 +366,7 @@ enums::httpProtocol packet::requestLineParser::getProtocol()
 
 std::string packet::requestLineParser::getRequestLineString()
 {
-    return(this->originalRequestLine);
+    return(std::move(this->originalRequestLine));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -400,7 +384,7 @@ std::string packet::requestLineParser::getStatusReason()
 
 server::uri packet::requestLineParser::getURI()
 {
-    return(this->uri);
+    return(std::move(this->uri));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -409,7 +393,7 @@ server::uri packet::requestLineParser::getURI()
 
 std::string packet::requestLineParser::getURIString()
 {
-    return(this->originalURIString);
+    return(std::move(this->originalURIString));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -474,17 +458,17 @@ enums::httpStatus packet::requestLineParser::parseAuthority(const std::string& i
 
 enums::httpStatus packet::requestLineParser::parseFragments(const std::string& inString)
 {
-    std::unique_ptr<utility::parseUtilities> parseUtil{new utility::parseUtilities()};
+    utility::parseUtilities parseUtil;
     std::string decodedStr;
     std::string workingStr;
 
-    if(!parseUtil->pctDecode(inString, decodedStr))
+    if(!parseUtil.pctDecode(inString, decodedStr))
     {
         this->statusReason = "Disallowed characters in fragment string";
         return(enums::httpStatus::BAD_REQUEST);
     }
 
-    parseUtil->toLower(decodedStr, workingStr);
+    parseUtil.toLower(decodedStr, workingStr);
     this->uri.setFragmentString(workingStr);
 
     while(workingStr.size() > 0)
@@ -514,17 +498,17 @@ enums::httpStatus packet::requestLineParser::parseFragments(const std::string& i
 
 enums::httpStatus packet::requestLineParser::parseHost(const std::string& inString)
 {
-    std::unique_ptr<utility::parseUtilities> parseUtil{new utility::parseUtilities()};
+    utility::parseUtilities parseUtil;
     std::string decodedStr;
     std::string workingStr;
     
-    if(!parseUtil->pctDecode(inString, decodedStr))
+    if(!parseUtil.pctDecode(inString, decodedStr))
     {
         this->statusReason = "Disallowed characters in host designation";
         return(enums::httpStatus::BAD_REQUEST);
     }
 
-    parseUtil->toLower(decodedStr, workingStr);
+    parseUtil.toLower(decodedStr, workingStr);
 
     size_t IPv6Found{workingStr.find_first_of("[:]")};
     if(IPv6Found != std::string::npos)
@@ -764,17 +748,17 @@ enums::httpStatus packet::requestLineParser::parseHostIP6(const std::string& inS
 
 enums::httpStatus packet::requestLineParser::parseParameters(const std::string& inString)
 {
-    std::unique_ptr<utility::parseUtilities> parseUtil{new utility::parseUtilities()};
+    utility::parseUtilities parseUtil;
     std::string decodedStr;
     std::string workingStr;
 
-    if(!parseUtil->pctDecode(inString, decodedStr))
+    if(!parseUtil.pctDecode(inString, decodedStr))
     {
         this->statusReason = "Disallowed characters in query string";
         return(enums::httpStatus::BAD_REQUEST);
     }
 
-    parseUtil->toLower(decodedStr, workingStr);
+    parseUtil.toLower(decodedStr, workingStr);
     this->uri.setParameterString(workingStr);
 
     while(workingStr.size() > 0)
@@ -815,56 +799,44 @@ enums::httpStatus packet::requestLineParser::parseParameters(const std::string&
 
 enums::httpStatus packet::requestLineParser::parsePath(const std::string& inString)
 {
-    std::unique_ptr<utility::parseUtilities> parseUtil{new utility::parseUtilities()};
-    this->uri.addSegment("RESOURCE_ROOT");
-    std::string workingStr{inString};
-    size_t slashFound{workingStr.find_first_of('/')};
-    if(slashFound == 0)
+    ///////////////////////////////////////////////////////////////////////////////
+    // validate only.  the router matches the raw path bytes and decodes
+    // just the segments it has to, so nothing is split or copied here
+    ///////////////////////////////////////////////////////////////////////////////
+
+    utility::parseUtilities parseUtil;
+    size_t pathIndex{0};
+    if(inString.size() > 0 && inString[0] == '/')
     {
-        workingStr.erase(0,1);
+        pathIndex = 1;
     }
 
-    while(workingStr.size() > 0)
+    size_t segmentLength{0};
+    for(; pathIndex < inString.size(); pathIndex++)
     {
-        slashFound = workingStr.find_first_of('/');
-        if(slashFound != std::string::npos)
+        char curChar{inString[pathIndex]};
+        if(curChar == '/')
         {
-            if(slashFound == 0)
+            if(segmentLength == 0)
             {
                 this->statusReason = "Invalid path segment";
                 return(enums::httpStatus::BAD_REQUEST);
             }
-            else
-            {
-                std::string encodedSegment{workingStr.substr(0, slashFound)};
-                workingStr.erase(0, slashFound + 1);
-                std::string decodedSegment;
-                std::string segment;
-                if(!parseUtil->pctDecode(encodedSegment, decodedSegment))
-                {
-                    this->statusReason = "Disallowed characters in path segment";
-                    return(enums::httpStatus::BAD_REQUEST);
-                }
-                parseUtil->toLower(decodedSegment, segment);
-                this->uri.addSegment(segment);
-            }
+            segmentLength = 0;
+            continue;
         }
-        else
+        if(curChar == '%')
         {
-            std::string encodedSegment{workingStr};
-            workingStr.clear();
-            std::string decodedSegment;
-            std::string segment;
-            if(!parseUtil->pctDecode(encodedSegment, decodedSegment))
+            if(pathIndex + 2 >= inString.size() || !parseUtil.isHex(inString[pathIndex + 1]) || !parseUtil.isHex(inString[pathIndex + 2]))
             {
                 this->statusReason = "Disallowed characters in path segment";
                 return(enums::httpStatus::BAD_REQUEST);
             }
-            parseUtil->toLower(decodedSegment, segment);
-            this->uri.addSegment(segment);
         }
+        segmentLength++;
     }
-    
+
+    this->uri.setRawPath(inString);
     return(enums::httpStatus::OK);
 }
 
@@ -1057,7 +1029,7 @@ enums::httpStatus packet::requestLineParser::parseURI()
 enums::httpStatus packet::requestLineParser::parseUserInfo(const std::string& inString)
 {
     
-    std::unique_ptr<utility::parseUtilities> parseUtil{new utility::parseUtilities()}; 
+    utility::parseUtilities parseUtil;
     std::string workingStr{inString};
     std::string encodedUserStr;
     std::string lowerUserStr;
@@ -1069,7 +1041,7 @@ enums::httpStatus packet::requestLineParser::parseUserInfo(const std::string& in
     if(colFound == std::string::npos)
     {
         encodedUserStr = workingStr;
-        if(!parseUtil->pctDecode(encodedUserStr, userString))
+        if(!parseUtil.pctDecode(encodedUserStr, userString))
         {
             this->statusReason = "Disallowed characters in username";
             return(enums::httpStatus::BAD_REQUEST);
@@ -1080,16 +1052,16 @@ enums::httpStatus packet::requestLineParser::parseUserInfo(const std::string& in
     else
     {
         encodedUserStr = workingStr.substr(0, colFound);
-        if(!parseUtil->pctDecode(encodedUserStr, userString))
+        if(!parseUtil.pctDecode(encodedUserStr, userString))
         {
             this->statusReason = "Disallowed characters in username";
             return(enums::httpStatus::BAD_REQUEST);
         }
-        parseUtil->toLower(userString, lowerUserStr);
+        parseUtil.toLower(userString, lowerUserStr);
         this->uri.setUsername(lowerUserStr);
         
         encodedPassStr = workingStr.substr(colFound + 1);
-        if(!parseUtil->pctDecode(encodedPassStr, passString))
+        if(!parseUtil.pctDecode(encodedPassStr, passString))
         {
             this->statusReason = "Disallowed characters in password";
             return(enums::httpStatus::BAD_REQUEST);
@@ -7,26 +7,48 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
 #include <chrono>
 #include <deque>
 #include <exception>
 #include <functional>
 #include <future>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <openssl/bio.h>
 #include <openssl/err.h>
 #include <openssl/ssl.h>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "../headers/frederick2_namespace.hpp"
 #include "../headers/http_request.hpp"
 #include "../headers/http_response.hpp"
 #include "../headers/server.hpp"
+#include "../headers/server_access_log.hpp"
+#include "../headers/server_cache.hpp"
 #include "../headers/server_connection.hpp"
 #include "../headers/server_enum.hpp"
+#include "../headers/server_handshake.hpp"
+#include "../headers/server_http2.hpp"
+#include "../headers/server_memory.hpp"
+#include "../headers/server_metrics.hpp"
+#include "../headers/server_middleware.hpp"
 #include "../headers/server_resource.hpp"
+#include "../headers/server_route.hpp"
+#include "../headers/server_route_registry.hpp"
 #include "../headers/server_socket.hpp"
+#include "../headers/server_stream_pool.hpp"
+#include "../headers/server_tickets.hpp"
 #include "../headers/server_uri.hpp"
+#include "../headers/utility_clock.hpp"
+#include "../headers/utility_compress.hpp"
 #include "../headers/utility_parse.hpp"
 
 namespace enums = frederick2::httpEnums;
@@ -38,6 +60,12 @@ namespace utility = frederick2::utility;
 // global variable definitions
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// metric labels, indexed by httpMethod; the converter maps are not safe to read concurrently
+static constexpr const char *metricMethodNames[]{"", "CONNECT", "DELETE", "GET", "HEAD", "OPTIONS", "PATCH", "POST", "PUT", "TRACE"};
+
+// stage labels, indexed by latencyStage
+static constexpr const char *metricStageNames[]{"queue", "tls", "headers", "body", "handler", "send", "total"};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // global function definitions
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -59,11 +87,198 @@ server::httpServer::httpServer()
     this->hasSSLCert = false;
     this->hasSSLKey = false;
     this->useSSL = false;
+    this->useHTTP2 = false;
+    this->useKTLS = false;
+    this->useCompression = false;
     this->runningWithSSL = false;
     this->bindPort = -1;
+    this->accessLogBytes = 0;
+    this->accessLogKeep = 5;
+    this->accessLogFormat = "%a - - %t \"%m %r\" %s %O %D";
+    this->cacheSize = 64 * 1024 * 1024;
+    this->compressionThreshold = 1024;
     this->connectionTimeout = 30;
+    this->handshakeTimeout = 10;
+    this->handshakeThreads = 0;
+    this->handshakeQueue = 0;
+    this->sessionCacheSize = 20480;
+    this->streamThreads = std::max<size_t>(4, std::thread::hardware_concurrency());
+    this->streamQueue = 1024;
+    this->ticketRotation = 3600;
+    this->tlsHandshakes = 0;
+    this->tlsResumptions = 0;
     this->listenQueue = -1;
     this->rootResource = new server::resource("RESOURCE_ROOT", enums::resourceType::STATIC);
+    this->cache = nullptr;
+    this->routes = new server::routeRegistry();
+    this->cryptoPool = nullptr;
+    this->streamWorkers = nullptr;
+    this->memory = new server::memoryGovernor();
+    this->metrics = new server::metricsRegistry();
+    this->metricIDs.accepted = this->metrics->getSeries(this->metrics->addCounter("frederick2_connections_accepted_total", "Connections accepted.", strVECTOR{}), {});
+    this->metricIDs.active = this->metrics->getSeries(this->metrics->addGauge("frederick2_connections_active", "Connections currently open.", strVECTOR{}), {});
+    this->metricIDs.requests = this->metrics->addCounter("frederick2_requests_total", "Requests answered, by method, route template and status.", strVECTOR{"method", "route", "status"});
+    this->metricIDs.bytesIn = this->metrics->getSeries(this->metrics->addCounter("frederick2_received_bytes_total", "Request bytes parsed.", strVECTOR{}), {});
+    this->metricIDs.bytesOut = this->metrics->getSeries(this->metrics->addCounter("frederick2_sent_bytes_total", "Response bytes written.", strVECTOR{}), {});
+    this->metricIDs.parseErrors = this->metrics->getSeries(this->metrics->addCounter("frederick2_parse_errors_total", "Requests rejected while parsing.", strVECTOR{}), {});
+    size_t timeoutFamily{this->metrics->addCounter("frederick2_timeouts_total", "Requests and idle connections that timed out.", strVECTOR{"kind"})};
+    this->metricIDs.requestTimeouts = this->metrics->getSeries(timeoutFamily, {"request"});
+    this->metricIDs.idleTimeouts = this->metrics->getSeries(timeoutFamily, {"idle"});
+    this->metricIDs.stages = this->metrics->addLatencyHistogram("frederick2_stage_seconds", "Time spent in each stage from accept to last byte, by route template.", strVECTOR{"stage", "route"});
+    for(size_t stageIndex = 0; stageIndex < server::httpServer::stageCount; stageIndex++)
+    {
+        this->metricIDs.unroutedStages[stageIndex] = this->metrics->getSeries(this->metricIDs.stages, {metricStageNames[stageIndex], ""});
+    }
+    this->metricIDs.accessLogDropped = this->metrics->getSeries(this->metrics->addCounter("frederick2_access_log_dropped_total", "Access log entries dropped because the writer fell behind.", strVECTOR{}), {});
+    this->accessLogger = nullptr;
+    server::memoryGovernor *memoryGauge{this->memory};
+    this->metrics->addGaugeFunction("frederick2_memory_bytes", "Bytes held in connection buffers, bodies and responses.", [memoryGauge](){ return(static_cast<double>(memoryGauge->getUsage())); });
+    this->tickets = nullptr;
+    this->compressionTypes.push_back("text/*");
+    this->compressionTypes.push_back("application/javascript");
+    this->compressionTypes.push_back("application/json");
+    this->compressionTypes.push_back("application/xml");
+    this->compressionTypes.push_back("image/svg+xml");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::acquireConnection
+///////////////////////////////////////////////////////////////////////////////
+
+server::connection* server::httpServer::acquireConnection()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // connections finish on their own threads and are accepted on this one,
+    // so the idle list is shared under a lock rather than kept per thread
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::lock_guard<std::mutex> idleGuard{this->connectionLock};
+    if(this->idleConnections.empty())
+    {
+        return(new server::connection(this));
+    }
+    server::connection *idleConn{this->idleConnections.back()};
+    this->idleConnections.pop_back();
+    return(idleConn);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::acquireRequest
+///////////////////////////////////////////////////////////////////////////////
+
+packet::httpRequest* server::httpServer::acquireRequest(std::string *inBuffer)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // requests, with their string capacity and arena block, are pooled by
+    // the server so they outlive the connection and stream threads that
+    // use them
+    ///////////////////////////////////////////////////////////////////////////////
+
+    packet::httpRequest *idleRequest{nullptr};
+    {
+        std::lock_guard<std::mutex> idleGuard{this->packetLock};
+        if(!this->idleRequests.empty())
+        {
+            idleRequest = this->idleRequests.back();
+            this->idleRequests.pop_back();
+        }
+    }
+    if(idleRequest == nullptr)
+    {
+        return(new packet::httpRequest(inBuffer));
+    }
+    idleRequest->reset(inBuffer);
+    return(idleRequest);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::acquireResponse
+///////////////////////////////////////////////////////////////////////////////
+
+packet::httpResponse* server::httpServer::acquireResponse(std::pmr::memory_resource *arenaResource)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // responses are built in the request's arena, so a response must be
+    // released before the request whose arena it used
+    ///////////////////////////////////////////////////////////////////////////////
+
+    packet::httpResponse *idleResponse{nullptr};
+    {
+        std::lock_guard<std::mutex> idleGuard{this->packetLock};
+        if(!this->idleResponses.empty())
+        {
+            idleResponse = this->idleResponses.back();
+            this->idleResponses.pop_back();
+        }
+    }
+    if(idleResponse == nullptr)
+    {
+        return(new packet::httpResponse(arenaResource));
+    }
+    idleResponse->reset(arenaResource);
+    return(idleResponse);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::addCompressionType
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::addCompressionType(const std::string& mimeType)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // exact media type (ie "application/wasm") or wildcard subtype ("font/*")
+    ///////////////////////////////////////////////////////////////////////////////
+    
+    this->compressionTypes.push_back(mimeType);
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::appendCachePath
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::appendCachePath(const std::string& rawPath, std::string& cacheKey)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // normalizes the path the way routeTable::match compares it, so /Items
+    // and /%69tems share one entry.  plain segments are only case folded;
+    // a segment that fails to decode, or decodes to hold '/' or one of the
+    // key's '?' and newline separators, is kept raw so it can never collide
+    // with a differently routed path
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string_view workingPath{rawPath};
+    if(workingPath.size() > 0 && workingPath[0] == '/')
+    {
+        workingPath.remove_prefix(1);
+    }
+
+    utility::parseUtilities parseUtil;
+    std::string decodedSegment;
+    while(workingPath.size() > 0)
+    {
+        size_t slashFound{workingPath.find('/')};
+        std::string_view rawSegment{workingPath.substr(0, slashFound)};
+        workingPath.remove_prefix(slashFound == std::string_view::npos ? workingPath.size() : slashFound + 1);
+
+        cacheKey.push_back('/');
+        if(rawSegment.find_first_of("%+") == std::string_view::npos)
+        {
+            for(char segmentChar : rawSegment)
+            {
+                cacheKey.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(segmentChar))));
+            }
+        }
+        else if(parseUtil.decodeSegment(rawSegment, decodedSegment) && decodedSegment.find_first_of("/?\n") == std::string::npos)
+        {
+            cacheKey.append(decodedSegment);
+        }
+        else
+        {
+            cacheKey.append(rawSegment);
+        }
+    }
+    return;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -78,6 +293,240 @@ void server::httpServer::destroyOpenSSL()
 }
 
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::dispatchResource
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::dispatchResource(packet::httpRequest *inbound, packet::httpResponse *outbound, dispatchState *state)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // innermost step of the middleware chain: response cache, then handler.
+    // a non-empty cacheKey left in state marks the response for storing.
+    // header names present before and after the handler let middleware
+    // headers be kept out of the cached head
+    ///////////////////////////////////////////////////////////////////////////////
+
+    server::resource *targetResource{state->target};
+    bool cacheHit{false};
+    if(this->cache != nullptr && targetResource->cacheTTL > 0 && state->method == enums::httpMethod::GET)
+    {
+        cacheHit = this->fetchCachedResponse(inbound, outbound, targetResource, state->cacheKey);
+    }
+
+    if(cacheHit)
+    {
+        state->cacheKey.clear();
+        return;
+    }
+
+    const httpHandler *resourceHandler{targetResource->findHandler(state->method)};
+    if(resourceHandler != nullptr)
+    {
+        bool trackHeaders{state->cacheKey.size() > 0 && targetResource->pipeline.size() > 0};
+        if(trackHeaders)
+        {
+            outbound->headers.collectNames(state->outerHeaders);
+        }
+        (*resourceHandler)(inbound, outbound);
+        if(state->cacheKey.size() > 0)
+        {
+            state->cacheTTL = this->prepareCachedResponse(outbound, targetResource);
+        }
+        if(trackHeaders)
+        {
+            outbound->headers.collectNames(state->innerHeaders);
+        }
+    }
+    else
+    {
+        state->cacheKey.clear();
+        outbound->setStatus(enums::httpStatus::METHOD_NOT_ALLOWED);
+        outbound->setStatusReason("Target resource does not support method");
+        outbound->addHeader("Allow", targetResource->allowList);
+    }
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::fetchCachedResponse
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::httpServer::fetchCachedResponse
+(packet::httpRequest *inbound, packet::httpResponse *outbound, server::resource *targetResource, std::string& cacheKey)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // key is method, normalized path, normalized query and declared Vary
+    // headers.  requests carrying credentials bypass the cache entirely so one user's
+    // response is never stored for or served to another (RFC 7234 3.2)
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(inbound->getHeaderView("Authorization").size() > 0)
+    {
+        cacheKey.clear();
+        return(false);
+    }
+
+    cacheKey.assign("GET ");
+    this->appendCachePath(inbound->uriObj.rawPath, cacheKey);
+    cacheKey.append("?");
+    cacheKey.append(inbound->uriObj.getParameterString());
+    cacheKey.append("\nAccept-Encoding:");
+    cacheKey.append(utility::compressor::coding2str(outbound->contentCoding));
+    for(const std::string& varyName : targetResource->cacheVary)
+    {
+        cacheKey.append("\n");
+        cacheKey.append(varyName);
+        cacheKey.append(":");
+        cacheKey.append(inbound->getHeaderView(varyName));
+    }
+
+    bool noStore{false};
+    bool noCache{false};
+    long maxAge{-1};
+    std::string_view reqCacheControl{inbound->getHeaderView("Cache-Control")};
+    if(reqCacheControl.size() > 0)
+    {
+        server::responseCache::parseCacheControl(std::string{reqCacheControl}, noStore, noCache, maxAge);
+    }
+    if(noStore)
+    {
+        cacheKey.clear();
+        return(false);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // no-cache and max-age=0 skip the stored body; the handler runs and its
+    // response refreshes the entry.  a positive max-age refuses entries
+    // older than the client will accept (RFC7234 [5.2.1.1])
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(noCache || maxAge == 0)
+    {
+        return(false);
+    }
+
+    size_t headLength{0};
+    long entryAge{0};
+    std::string etag;
+    std::string varyValue;
+    std::string cacheControl;
+    std::shared_ptr<const std::string> payload;
+    if(!this->cache->fetch(cacheKey, payload, headLength, etag, varyValue, cacheControl, entryAge))
+    {
+        return(false);
+    }
+    if(maxAge > 0 && entryAge > maxAge)
+    {
+        return(false);
+    }
+
+    std::string_view ifNoneMatch{inbound->getHeaderView("If-None-Match")};
+    if(ifNoneMatch.size() > 0 && server::responseCache::matchETag(ifNoneMatch, etag))
+    {
+        outbound->setStatus(enums::httpStatus::NOT_MODIFIED);
+        outbound->addHeader("ETag", etag);
+        if(varyValue.size() > 0)
+        {
+            outbound->addHeader("Vary", varyValue);
+        }
+        if(cacheControl.size() > 0)
+        {
+            outbound->addHeader("Cache-Control", cacheControl);
+        }
+    }
+    else
+    {
+        outbound->setCachedPayload(std::move(payload), headLength);
+    }
+    
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::getAccessLogDropped
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::httpServer::getAccessLogDropped()
+{
+    if(this->accessLogger == nullptr)
+    {
+        return(0);
+    }
+    return(this->accessLogger->getDropped());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::getHandshakeQueueDepth
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::httpServer::getHandshakeQueueDepth()
+{
+    if(this->cryptoPool == nullptr)
+    {
+        return(0);
+    }
+    return(this->cryptoPool->getQueueDepth());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::getHandshakeQueuePeak
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::httpServer::getHandshakeQueuePeak()
+{
+    if(this->cryptoPool == nullptr)
+    {
+        return(0);
+    }
+    return(this->cryptoPool->queuePeak.load());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::getHandshakesRejected
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::httpServer::getHandshakesRejected()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // handshakes refused because the queue was full or their deadline
+    // passed before a pool thread picked them up
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->cryptoPool == nullptr)
+    {
+        return(0);
+    }
+    return(this->cryptoPool->rejected.load());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::getMemoryUsage
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::httpServer::getMemoryUsage()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // bytes currently held in receive buffers, request bodies and
+    // serialized responses across all connections
+    ///////////////////////////////////////////////////////////////////////////////
+
+    return(this->memory->getUsage());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::getMetrics
+///////////////////////////////////////////////////////////////////////////////
+
+server::metricsRegistry* server::httpServer::getMetrics()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // applications may register their own families here; register them
+    // before start() so the request path only ever resolves series
+    ///////////////////////////////////////////////////////////////////////////////
+
+    return(this->metrics);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::httpServer::getResourceTree
 ///////////////////////////////////////////////////////////////////////////////
@@ -87,15 +536,84 @@ server::resource* server::httpServer::getResourceTree()
     return(this->rootResource);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::getStageLatency
+///////////////////////////////////////////////////////////////////////////////
+
+double server::httpServer::getStageLatency(const std::string& routeTemplate, enums::latencyStage targetStage, double quantileRank)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // seconds at quantileRank (0.5, 0.99, ...) for one stage of one route
+    // template as labelled on /metrics, e.g. "/items/{id}".  an empty
+    // route reads the connection stages and requests that matched nothing
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t stageIndex{static_cast<size_t>(targetStage)};
+    if(stageIndex >= server::httpServer::stageCount)
+    {
+        return(0);
+    }
+    if(routeTemplate.size() == 0)
+    {
+        return(this->metrics->quantile(this->metricIDs.unroutedStages[stageIndex], quantileRank));
+    }
+
+    size_t seriesSlot{0};
+    {
+        server::routeRegistry::readGuard routeSnapshot{this->routes};
+        if(routeSnapshot.table != nullptr)
+        {
+            for(const server::routeTable::routeNode& curNode : routeSnapshot.table->nodes)
+            {
+                if(curNode.target->routePath == routeTemplate)
+                {
+                    seriesSlot = curNode.target->stageSeries[stageIndex];
+                    break;
+                }
+            }
+        }
+    }
+    return(this->metrics->quantile(seriesSlot, quantileRank));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::getTLSHandshakes
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::httpServer::getTLSHandshakes()
+{
+    return(this->tlsHandshakes.load());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::getTLSResumptions
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::httpServer::getTLSResumptions()
+{
+    return(this->tlsResumptions.load());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::httpServer::handleRequest
 ///////////////////////////////////////////////////////////////////////////////
 
-packet::httpResponse *server::httpServer::handleRequest(packet::httpRequest *inbound)
+packet::httpResponse *server::httpServer::handleRequest(packet::httpRequest *inbound, bool zeroCopy)
 {
     bool errorResponse{false};
-    packet::httpResponse *outbound{new packet::httpResponse()};
+    enums::httpMethod metricMethod{inbound->getStatus() == enums::httpStatus::OK ? inbound->getMethod() : enums::httpMethod::ENUMERROR};
+    size_t cacheTTL{0};
+    std::string cacheKey;
+    std::vector<std::string> middlewareHeaders;
+    packet::httpResponse *outbound{this->acquireResponse(inbound->arena->getResource())};
     server::resource *targetResource{nullptr};
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // pin the current route snapshot for the whole request; the resource,
+    // its handlers and any path parameter names live inside it
+    ///////////////////////////////////////////////////////////////////////////////
+
+    server::routeRegistry::readGuard routeSnapshot{this->routes};
     
     // check for error detected during request parse/build
     if(inbound->getStatus() != enums::httpStatus::OK)
@@ -104,6 +622,17 @@ packet::httpResponse *server::httpServer::handleRequest(packet::httpRequest *inb
         if(inbound->getStatus() == enums::httpStatus::REQUEST_TIMEOUT)
         {
             inbound->addHeader("Connection", "close");
+            this->metrics->increment(this->metricIDs.requestTimeouts);
+        }
+        else if(inbound->getStatus() != enums::httpStatus::SERVICE_UNAVAILABLE)
+        {
+            this->metrics->increment(this->metricIDs.parseErrors);
+        }
+        if(inbound->getStatus() == enums::httpStatus::SERVICE_UNAVAILABLE)
+        {
+            // refused body is still unread on the wire
+            inbound->addHeader("Connection", "close");
+            outbound->addHeader("Retry-After", std::to_string(this->memory->retryAfter));
         }
         outbound->setStatus(inbound->getStatus());
         outbound->setStatusReason(inbound->getStatusReason());        
@@ -125,12 +654,21 @@ packet::httpResponse *server::httpServer::handleRequest(packet::httpRequest *inb
     // identify target resource
     if(!errorResponse)
     {   
-        targetResource = this->lookupResource(inbound);
+        targetResource = this->lookupResource(routeSnapshot.table, inbound);
         if(targetResource == nullptr)
         {
             errorResponse = true;
-            outbound->setStatus(enums::httpStatus::NOT_FOUND);
-            outbound->setStatusReason("Target Resource Not Found");
+            if(inbound->getStatus() != enums::httpStatus::OK)
+            {
+                // typed path parameter rejected while routing
+                outbound->setStatus(inbound->getStatus());
+                outbound->setStatusReason(inbound->getStatusReason());
+            }
+            else
+            {
+                outbound->setStatus(enums::httpStatus::NOT_FOUND);
+                outbound->setStatusReason("Target Resource Not Found");
+            }
         }
     }
 
@@ -144,28 +682,85 @@ packet::httpResponse *server::httpServer::handleRequest(packet::httpRequest *inb
             inbound->setMethod(enums::httpMethod::GET);
             reqMethod = enums::httpMethod::GET;
         }
-        handlerCheck resourceHandler{targetResource->getHandler(reqMethod)};
-        if(resourceHandler.first){
-            resourceHandler.second(inbound, outbound);
+        if(this->useCompression)
+        {
+            std::string_view acceptEncoding{inbound->getHeaderView("Accept-Encoding")};
+            enums::contentCoding acceptCoding{enums::contentCoding::IDENTITY};
+            if(acceptEncoding.size() > 0)
+            {
+                acceptCoding = utility::compressor::negotiate(std::string{acceptEncoding});
+            }
+            outbound->setCompression(acceptCoding, this->compressionThreshold, &this->compressionTypes);
+        }
+
+        dispatchState requestState{targetResource, reqMethod};
+        inbound->stages.handlerStart = utility::cycleClock::now();
+        if(targetResource->pipeline.size() == 0)
+        {
+            this->dispatchResource(inbound, outbound, &requestState);
         }
         else
         {
-            outbound->setStatus(enums::httpStatus::METHOD_NOT_ALLOWED);
-            outbound->setStatusReason("Target resource does not support method");
-            outbound->addHeader("Allow", targetResource->getMethodList());
+            server::middlewareChain resourceChain{&targetResource->pipeline, inbound, outbound, this, &requestState};
+            resourceChain.next();
+        }
+        inbound->stages.handlerEnd = utility::cycleClock::now();
+        cacheKey = std::move(requestState.cacheKey);
+        cacheTTL = requestState.cacheTTL;
+        middlewareHeaders = std::move(requestState.outerHeaders);
+        if(cacheKey.size() > 0 && requestState.innerHeaders.size() > 0)
+        {
+            // headers added by middleware after the handler returned
+            std::vector<std::string> finalHeaders;
+            outbound->headers.collectNames(finalHeaders);
+            for(std::string& headerName : finalHeaders)
+            {
+                if(std::find(requestState.innerHeaders.begin(), requestState.innerHeaders.end(), headerName) == requestState.innerHeaders.end())
+                {
+                    middlewareHeaders.push_back(std::move(headerName));
+                }
+            }
         }
     }
 
     // update content headers 
+    outbound->setZeroCopy(zeroCopy);
     outbound->handleContent();
+
+    // store cacheable response and revalidate against If-None-Match
+    if(cacheKey.size() > 0)
+    {
+        outbound = this->storeCachedResponse(inbound, outbound, cacheKey, cacheTTL, middlewareHeaders);
+    }
     
     // identify and set appropriate close header
-    std::string connHeaderValue{inbound->getHeader("Connection")};
+    std::string_view connHeaderValue{inbound->getHeaderView("Connection")};
     if(connHeaderValue.size() == 0)
     {
-        connHeaderValue.append("close");
+        connHeaderValue = "close";
+    }
+    outbound->addHeader("Connection", std::string{connHeaderValue});
+
+    // count the request by method, route template and final status
+    char statusBuffer[8];
+    std::to_chars_result statusResult{std::to_chars(statusBuffer, statusBuffer + sizeof(statusBuffer), static_cast<int>(outbound->getStatus()))};
+    size_t methodIndex{static_cast<size_t>(metricMethod)};
+    std::string_view methodLabel{methodIndex < std::size(metricMethodNames) ? metricMethodNames[methodIndex] : ""};
+    std::string_view routeLabel{targetResource != nullptr ? std::string_view{targetResource->routePath} : std::string_view{}};
+    this->metrics->increment(this->metrics->getSeries(this->metricIDs.requests, {methodLabel, routeLabel, std::string_view{statusBuffer, static_cast<size_t>(statusResult.ptr - statusBuffer)}}));
+    this->metrics->add(this->metricIDs.bytesIn, static_cast<int64_t>(inbound->bytesReceived));
+
+    // stage series are copied out; the snapshot may be gone by the last byte
+    inbound->stageSeries = targetResource != nullptr ? targetResource->stageSeries : this->metricIDs.unroutedStages;
+    if(this->accessLogger != nullptr)
+    {
+        server::accessLog::logEntry& newEntry{inbound->logEntry};
+        newEntry.method = metricMethod;
+        newEntry.status = static_cast<uint16_t>(outbound->getStatus());
+        newEntry.bytesIn = inbound->bytesReceived;
+        newEntry.routeLength = static_cast<uint8_t>(std::min(routeLabel.size(), newEntry.route.size()));
+        std::copy_n(routeLabel.data(), newEntry.routeLength, newEntry.route.data());
     }
-    outbound->addHeader("Connection", connHeaderValue);
     
     return(outbound);
 }
@@ -182,44 +777,267 @@ void server::httpServer::initializeOpenSSL()
     return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::logAccess
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::logAccess(packet::httpRequest *inbound, const struct sockaddr *peerAddress, size_t bytesSent, uint64_t lastByte)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // completes the entry handleRequest started and hands it to the
+    // logger's ring for this thread; formatting and disk I/O happen on the
+    // logger's own thread
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->accessLogger == nullptr)
+    {
+        return;
+    }
+    server::accessLog::logEntry& newEntry{inbound->logEntry};
+    const packet::httpRequest::stageClock& stamps{inbound->stages};
+    server::accessLog::copyPeer(newEntry, peerAddress);
+    newEntry.bytesOut = bytesSent;
+    newEntry.finishTicks = lastByte;
+    newEntry.totalTicks = lastByte > stamps.firstByte ? lastByte - stamps.firstByte : 0;
+    newEntry.handlerTicks = stamps.handlerEnd > stamps.handlerStart ? stamps.handlerEnd - stamps.handlerStart : 0;
+    if(!this->accessLogger->push(newEntry))
+    {
+        this->metrics->increment(this->metricIDs.accessLogDropped);
+    }
+    return;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::httpServer::lookupResource
 ///////////////////////////////////////////////////////////////////////////////
 
-server::resource* server::httpServer::lookupResource(packet::httpRequest* inbound)
+server::resource* server::httpServer::lookupResource(const server::routeTable *routeSnapshot, packet::httpRequest* inbound)
 {
-    server::uri requestURI{inbound->getURI()};
-    std::deque<std::string> requestSegments{requestURI.getSegments()};
-    server::resource *targetResource{this->rootResource};
-    if(requestSegments.front() != "RESOURCE_ROOT")
+    if(routeSnapshot == nullptr)
     {
         return(nullptr);
     }
-    if(requestSegments.size() == 1)
+    return(routeSnapshot->match(inbound));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::prepareCachedResponse
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::httpServer::prepareCachedResponse(packet::httpResponse *outbound, server::resource *targetResource)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // returns the ttl to store the response with or 0 if it cannot be stored
+    // ETag and Vary are set before content handling so HEAD responses match GET
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(outbound->getStatus() != enums::httpStatus::OK)
+    {
+        return(0);
+    }
+
+    if(outbound->contentFilePath.size() > 0)
+    {
+        return(0);
+    }
+
+    if(targetResource->cacheVary.size() > 0 && outbound->getHeader("Vary").size() == 0)
     {
-        return(targetResource);
+        std::string varyValue;
+        for(const std::string& varyName : targetResource->cacheVary)
+        {
+            if(varyValue.size() > 0)
+            {
+                varyValue.append(", ");
+            }
+            varyValue.append(varyName);
+        }
+        outbound->addHeader("Vary", varyValue);
     }
-    requestSegments.pop_front();
-    while(targetResource != nullptr && requestSegments.size() > 0)
+
+    if(outbound->getHeader("ETag").size() == 0)
     {
-        if(targetResource->getType() == enums::resourceType::FILESYSTEM)
+        outbound->addHeader("ETag", server::responseCache::buildETag(outbound->content));
+    }
+
+    if(outbound->headers.has("Set-Cookie"))
+    {
+        return(0);
+    }
+
+    size_t ttl{targetResource->cacheTTL};
+    std::string respCacheControl{outbound->getHeader("Cache-Control")};
+    if(respCacheControl.size() > 0)
+    {
+        bool noStore{false};
+        bool noCache{false};
+        long maxAge{-1};
+        if(!server::responseCache::parseCacheControl(respCacheControl, noStore, noCache, maxAge))
         {
-            inbound->addFileSegment(requestSegments.front());
+            return(0);
         }
-        else
+        if(noStore || noCache)
         {
-            targetResource = targetResource->getChild(requestSegments.front());
-            if(targetResource != nullptr)
-            {
-                if(targetResource->getType() == enums::resourceType::DYNAMIC)
-                {
-                    inbound->addPathParameter(targetResource->getName(), requestSegments.front());
-                }
-            }            
-        }        
-        requestSegments.pop_front();
+            return(0);
+        }
+        if(maxAge >= 0)
+        {
+            ttl = maxAge;
+        }
+    }
+
+    return(ttl);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::prepareRoutes
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::prepareRoutes(server::routeTable *newTable)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // resolve every route's stage series while the table is still private,
+    // so the request path indexes an array instead of looking up labels.
+    // queue and tls happen before any route is known and stay unrouted
+    ///////////////////////////////////////////////////////////////////////////////
+
+    for(server::routeTable::routeNode& curNode : newTable->nodes)
+    {
+        server::resource *curResource{curNode.target};
+        curResource->stageSeries = this->metricIDs.unroutedStages;
+        for(size_t stageIndex = static_cast<size_t>(enums::latencyStage::HEADERS); stageIndex < server::httpServer::stageCount; stageIndex++)
+        {
+            curResource->stageSeries[stageIndex] = this->metrics->getSeries(this->metricIDs.stages, {metricStageNames[stageIndex], curResource->routePath});
+        }
+    }
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::recordHandshake
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::recordHandshake(bool resumed)
+{
+    this->tlsHandshakes.fetch_add(1, std::memory_order_relaxed);
+    if(resumed)
+    {
+        this->tlsResumptions.fetch_add(1, std::memory_order_relaxed);
+    }
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::recordStages
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::recordStages(packet::httpRequest *inbound, uint64_t lastByte)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // called once the last byte of the response is written.  stamps are
+    // raw cycleClock ticks and may come from different threads, so a
+    // stamp that reads earlier than the one before it counts as zero
+    ///////////////////////////////////////////////////////////////////////////////
+
+    const packet::httpRequest::stageClock& stamps{inbound->stages};
+    const std::array<size_t, server::httpServer::stageCount>& stageSeries{inbound->stageSeries};
+    auto tickSpan{[](uint64_t spanStart, uint64_t spanEnd){ return(spanEnd > spanStart ? spanEnd - spanStart : 0); }};
+    if(stamps.firstByte == 0)
+    {
+        return;
+    }
+
+    std::array<size_t, server::httpServer::stageCount> sampleSeries;
+    std::array<uint64_t, server::httpServer::stageCount> sampleTicks;
+    size_t sampleCount{0};
+    auto addSample{[&](enums::latencyStage curStage, uint64_t spanStart, uint64_t spanEnd){
+        sampleSeries[sampleCount] = stageSeries[static_cast<size_t>(curStage)];
+        sampleTicks[sampleCount] = tickSpan(spanStart, spanEnd);
+        sampleCount++;
+    }};
+
+    addSample(enums::latencyStage::HEADERS, stamps.firstByte, stamps.headersDone);
+    if(inbound->hasContent)
+    {
+        addSample(enums::latencyStage::BODY, stamps.headersDone, stamps.bodyDone);
+    }
+    uint64_t sendStart{stamps.bodyDone};
+    if(stamps.handlerStart != 0)
+    {
+        addSample(enums::latencyStage::HANDLER, stamps.handlerStart, stamps.handlerEnd);
+        sendStart = stamps.handlerEnd;
+    }
+    addSample(enums::latencyStage::SEND, sendStart, lastByte);
+    addSample(enums::latencyStage::TOTAL, stamps.firstByte, lastByte);
+    this->metrics->observeTicks(sampleSeries.data(), sampleTicks.data(), sampleCount);
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::releaseConnection
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::releaseConnection(server::connection *finishedConn)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // reset outside the lock; the connection keeps its io buffer and
+    // string capacity for the next accept
+    ///////////////////////////////////////////////////////////////////////////////
+
+    finishedConn->reset();
+    {
+        std::lock_guard<std::mutex> idleGuard{this->connectionLock};
+        if(this->idleConnections.size() < server::httpServer::idleLimit)
+        {
+            this->idleConnections.push_back(finishedConn);
+            return;
+        }
+    }
+    delete finishedConn;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::releaseRequest
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::releaseRequest(packet::httpRequest *finishedRequest)
+{
+    if(finishedRequest == nullptr)
+    {
+        return;
+    }
+    finishedRequest->recycle();
+    {
+        std::lock_guard<std::mutex> idleGuard{this->packetLock};
+        if(this->idleRequests.size() < server::httpServer::idleLimit)
+        {
+            this->idleRequests.push_back(finishedRequest);
+            return;
+        }
+    }
+    delete finishedRequest;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::releaseResponse
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::releaseResponse(packet::httpResponse *finishedResponse)
+{
+    if(finishedResponse == nullptr)
+    {
+        return;
+    }
+    finishedResponse->recycle();
+    {
+        std::lock_guard<std::mutex> idleGuard{this->packetLock};
+        if(this->idleResponses.size() < server::httpServer::idleLimit)
+        {
+            this->idleResponses.push_back(finishedResponse);
+            return;
+        }
     }
-    return(targetResource);
+    delete finishedResponse;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -253,8 +1071,11 @@ bool server::httpServer::runServer(std::future<void> exitSignal)
     {
         if(listenSock->pollIn())
         {
-            server::connection *newConn{new server::connection(this)};
+            server::connection *newConn{this->acquireConnection()};
             newConn->setMaxTime(this->connectionTimeout);
+            newConn->setHandshakeTime(this->handshakeTimeout);
+            newConn->setHandshakePool(this->cryptoPool);
+            newConn->setUseHTTP2(this->useHTTP2);
             if(this->runningWithSSL){
                 newConn->setUseSSL(true);
                 newConn->setSSLContext(this->sslContext);
@@ -263,11 +1084,40 @@ bool server::httpServer::runServer(std::future<void> exitSignal)
             }
             if(newConn->acceptConnection(listenSock->getFD()))
             {
-                auto funcPtr = &server::connection::handleConnection;
+                this->metrics->increment(this->metricIDs.accepted);
+                this->metrics->add(this->metricIDs.active, 1);
+                auto funcPtr = &server::httpServer::serveConnection;
                 std::promise<void> childPromise;
                 std::future<void> childExit{childPromise.get_future()};
                 this->childPromises.push_back(std::move(childPromise));
-                this->childFutures.push_back(std::async(std::launch::async, funcPtr, newConn, std::move(childExit)));
+                this->childFutures.push_back(std::async(std::launch::async, funcPtr, this, newConn, std::move(childExit)));
+            }
+            else
+            {
+                this->releaseConnection(newConn);
+            }
+
+            ///////////////////////////////////////////////////////////////////////////////
+            // forget connections that already finished so the lists track
+            // live connections only
+            ///////////////////////////////////////////////////////////////////////////////
+
+            size_t childIndex{0};
+            while(childIndex < this->childFutures.size())
+            {
+                if(this->childFutures[childIndex].wait_for(std::chrono::milliseconds(0)) != std::future_status::ready)
+                {
+                    childIndex++;
+                    continue;
+                }
+                if(!this->childFutures[childIndex].get())
+                {
+                    throw std::runtime_error("wtf: connection::handleConnection returned false");
+                }
+                this->childFutures[childIndex] = std::move(this->childFutures.back());
+                this->childFutures.pop_back();
+                this->childPromises[childIndex] = std::move(this->childPromises.back());
+                this->childPromises.pop_back();
             }
         }
         signalStatus = exitSignal.wait_for(std::chrono::milliseconds(0));                
@@ -302,6 +1152,90 @@ bool server::httpServer::runServer(std::future<void> exitSignal)
     return(true);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::serveConnection
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::httpServer::serveConnection(server::connection *newConn, std::future<void> exitSignal)
+{
+    bool connFinished{newConn->handleConnection(std::move(exitSignal))};
+    this->metrics->add(this->metricIDs.active, -1);
+    this->releaseConnection(newConn);
+    return(connFinished);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::serveMetrics
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::serveMetrics(server::resource *metricsResource)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // mounts a Prometheus scrape target on the given resource, for
+    // example root->addChild("metrics", resourceType::STATIC)
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(metricsResource == nullptr)
+    {
+        return;
+    }
+    server::metricsRegistry *registry{this->metrics};
+    metricsResource->addHandler(enums::httpMethod::GET, [registry](packet::httpRequest*, packet::httpResponse *response)
+    {
+        response->setContent(registry->render());
+        response->addHeader("Content-Type", "text/plain; version=0.0.4; charset=utf-8");
+        response->setStatus(enums::httpStatus::OK);
+    });
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setAccessLog
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setAccessLog(const std::string& logPath)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // file the access log is appended to from the next start(); an empty
+    // path turns it off
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->accessLogPath = logPath;
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setAccessLogFormat
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setAccessLogFormat(const std::string& logFormat)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // line template: %a peer, %t time [CLF], %T time ISO 8601, %m method,
+    // %r route, %s status, %I bytes in, %O bytes out, %D total and
+    // %H handler microseconds, %% percent
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->accessLogFormat = logFormat;
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setAccessLogRotation
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setAccessLogRotation(size_t maxBytes, size_t keepFiles)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // rotate once the file would pass maxBytes (0 never rotates), keeping
+    // keepFiles old files as path.1, path.2 ...
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->accessLogBytes = maxBytes;
+    this->accessLogKeep = keepFiles;
+    return;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::httpServer::setBindAddress
 ///////////////////////////////////////////////////////////////////////////////
@@ -335,6 +1269,56 @@ void server::httpServer::setListenQueue(int queueSize)
     return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setMemoryLimits
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setMemoryLimits(size_t softBytes, size_t hardBytes)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // above softBytes the heaviest connections stop reading until usage
+    // falls back.  above hardBytes new request bodies are refused with 503.
+    // zero disables either mark
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->memory->setLimits(softBytes, hardBytes);
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setCacheSize
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setCacheSize(size_t maxBytes)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // byte budget for the response cache.  0 disables caching server wide
+    ///////////////////////////////////////////////////////////////////////////////
+    
+    this->cacheSize = maxBytes;
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setCompression
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setCompression(bool compressFlag)
+{
+    this->useCompression = compressFlag;
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setCompressionThreshold
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setCompressionThreshold(size_t minBytes)
+{
+    this->compressionThreshold = minBytes;
+    return;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::httpServer::setConnectionTimeout
 ///////////////////////////////////////////////////////////////////////////////
@@ -345,6 +1329,51 @@ void server::httpServer::setConnectionTimeout(size_t timeout)
     return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setHandshakePool
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setHandshakePool(size_t threadCount, size_t queueLimit)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // threadCount bounds concurrent handshake crypto, queueLimit bounds the
+    // handshake steps waiting for a thread.  0 threads runs handshakes on
+    // the connection threads
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->handshakeThreads = threadCount;
+    this->handshakeQueue = queueLimit;
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setHandshakeTimeout
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setHandshakeTimeout(size_t timeout)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // seconds a TLS client gets to complete its handshake
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->handshakeTimeout = timeout;
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setSessionCacheSize
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setSessionCacheSize(size_t entryCount)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // 0 disables the server side session cache
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->sessionCacheSize = entryCount;
+    return;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::httpServer::setSSLPrivateKey
 ///////////////////////////////////////////////////////////////////////////////
@@ -367,6 +1396,57 @@ void server::httpServer::setSSLPublicCert(const std::string& certPath)
     return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setStreamPool
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setStreamPool(size_t threadCount, size_t queueLimit)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // threadCount bounds HTTP/2 handlers running at once across every
+    // connection, queueLimit bounds the streams waiting for a thread.
+    // streams past that wait in their own session
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->streamThreads = threadCount > 0 ? threadCount : 1;
+    this->streamQueue = queueLimit;
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setTicketRotation
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setTicketRotation(size_t rotationSeconds)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // 0 disables session tickets, resumption then relies on the session cache
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->ticketRotation = rotationSeconds;
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setUseHTTP2
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setUseHTTP2(bool http2Flag)
+{
+    this->useHTTP2 = http2Flag;
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::setUseKTLS
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::setUseKTLS(bool ktlsFlag)
+{
+    this->useKTLS = ktlsFlag;
+    return;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::httpServer::setUseSSL
 ///////////////////////////////////////////////////////////////////////////////
@@ -406,6 +1486,16 @@ bool server::httpServer::start()
         sslOptions |= SSL_OP_NO_SSLv3;
         sslOptions |= SSL_OP_NO_TLSv1;
         sslOptions |= SSL_OP_NO_TLSv1_1;
+        if(this->useKTLS)
+        {
+            ///////////////////////////////////////////////////////////////////////////////
+            // record encryption moves into the kernel once the handshake completes
+            // OpenSSL silently keeps user space records when the kernel or
+            // negotiated cipher cannot support it
+            ///////////////////////////////////////////////////////////////////////////////
+
+            sslOptions |= SSL_OP_ENABLE_KTLS;
+        }
         SSL_CTX_set_options(this->sslContext, sslOptions);
         int sslError{0};
         sslError = SSL_CTX_use_certificate_file(this->sslContext, this->sslCertPath.c_str(), SSL_FILETYPE_PEM);
@@ -418,8 +1508,78 @@ bool server::httpServer::start()
         {
             return(false);
         }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // resumption: stateful cache keyed by session id plus stateless tickets
+        // encrypted under in-process keys that rotate every ticketRotation seconds
+        ///////////////////////////////////////////////////////////////////////////////
+
+        const unsigned char sessionContext[]{"frederick2"};
+        SSL_CTX_set_session_id_context(this->sslContext, sessionContext, sizeof(sessionContext) - 1);
+        if(this->sessionCacheSize > 0)
+        {
+            SSL_CTX_set_session_cache_mode(this->sslContext, SSL_SESS_CACHE_SERVER);
+            SSL_CTX_sess_set_cache_size(this->sslContext, this->sessionCacheSize);
+        }
+        else
+        {
+            SSL_CTX_set_session_cache_mode(this->sslContext, SSL_SESS_CACHE_OFF);
+        }
+        if(this->ticketRotation > 0)
+        {
+            if(this->tickets == nullptr)
+            {
+                this->tickets = new server::ticketKeys(this->ticketRotation);
+            }
+            if(!this->tickets->attach(this->sslContext))
+            {
+                return(false);
+            }
+            SSL_CTX_set_timeout(this->sslContext, this->ticketRotation * 2);
+        }
+        else
+        {
+            SSL_CTX_set_options(this->sslContext, SSL_OP_NO_TICKET);
+        }
+        if(this->useHTTP2)
+        {
+            SSL_CTX_set_alpn_select_cb(this->sslContext, &server::http2Session::selectProtocol, nullptr);
+        }
+    }
+
+    if(this->useSSL && this->cryptoPool == nullptr && this->handshakeThreads > 0)
+    {
+        this->cryptoPool = new server::handshakePool(this->handshakeThreads, this->handshakeQueue);
+    }
+
+    if(this->useHTTP2 && this->streamWorkers == nullptr)
+    {
+        this->streamWorkers = new server::streamPool(this->streamThreads, this->streamQueue);
+    }
+
+    if(this->cache == nullptr && this->cacheSize > 0)
+    {
+        this->cache = new server::responseCache(this->cacheSize);
+    }
+
+    if(this->accessLogger == nullptr && this->accessLogPath.size() > 0)
+    {
+        this->accessLogger = new server::accessLog(this->accessLogPath, this->accessLogFormat, this->accessLogBytes, this->accessLogKeep);
+        if(!this->accessLogger->isOpen())
+        {
+            delete this->accessLogger;
+            this->accessLogger = nullptr;
+            return(false);
+        }
     }
 
+    ///////////////////////////////////////////////////////////////////////////////
+    // publish the resource tree as the first route table snapshot.
+    // later changes go through updateRoutes()
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->routes->update(this->rootResource, nullptr, [this](server::routeTable *newTable){ this->prepareRoutes(newTable); });
+
     this->didAsyncStart = safeStart;
     this->runningWithSSL = this->useSSL;
     
@@ -429,6 +1589,56 @@ bool server::httpServer::start()
     return(safeStart);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::storeCachedResponse
+///////////////////////////////////////////////////////////////////////////////
+
+packet::httpResponse *server::httpServer::storeCachedResponse
+(packet::httpRequest *inbound, packet::httpResponse *outbound, const std::string& cacheKey, size_t cacheTTL, const std::vector<std::string>& middlewareHeaders)
+{
+    if(outbound->getStatus() != enums::httpStatus::OK)
+    {
+        return(outbound);
+    }
+
+    std::string etag{outbound->getHeader("ETag")};
+    std::string varyValue{outbound->getHeader("Vary")};
+    std::string cacheControl{outbound->getHeader("Cache-Control")};
+    if(cacheTTL > 0 && outbound->requestMethod == enums::httpMethod::GET)
+    {
+        size_t headLength{0};
+        std::string serialized{outbound->toCacheString(headLength, middlewareHeaders)};
+        this->cache->store(cacheKey, std::move(serialized), headLength, etag, varyValue, cacheControl, cacheTTL);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // client already holds the current representation
+    // replace the full response with a 304
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string_view ifNoneMatch{inbound->getHeaderView("If-None-Match")};
+    if(etag.size() > 0 && ifNoneMatch.size() > 0 && server::responseCache::matchETag(ifNoneMatch, etag))
+    {
+        packet::httpResponse *notModified{this->acquireResponse(inbound->arena->getResource())};
+        notModified->setRequestMethod(outbound->requestMethod);
+        notModified->setStatus(enums::httpStatus::NOT_MODIFIED);
+        notModified->addHeader("ETag", etag);
+        if(varyValue.size() > 0)
+        {
+            notModified->addHeader("Vary", varyValue);
+        }
+        if(cacheControl.size() > 0)
+        {
+            notModified->addHeader("Cache-Control", cacheControl);
+        }
+        notModified->handleContent();
+        this->releaseResponse(outbound);
+        outbound = notModified;
+    }
+
+    return(outbound);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::httpServer::stop
 ///////////////////////////////////////////////////////////////////////////////
@@ -447,16 +1657,98 @@ void server::httpServer::stop()
     if(this->runningWithSSL){
         this->destroyOpenSSL();
     } 
+    if(this->streamWorkers != nullptr)
+    {
+        // every session has finished, so no stream task is left queued
+        delete this->streamWorkers;
+        this->streamWorkers = nullptr;
+    }
+    if(this->accessLogger != nullptr)
+    {
+        // every connection has finished, so this flushes all of them
+        delete this->accessLogger;
+        this->accessLogger = nullptr;
+    }
     this->runningWithSSL = false;
     this->didAsyncStart = false;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::httpServer::updateRoutes
+///////////////////////////////////////////////////////////////////////////////
+
+void server::httpServer::updateRoutes(const std::function<void(server::resource*)>& editRoutes)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // runs editRoutes against the resource tree and publishes the result.
+    // requests in flight finish on the snapshot they started with
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->routes->update(this->rootResource, editRoutes, [this](server::routeTable *newTable){ this->prepareRoutes(newTable); });
+    return;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Deconstructor
 ///////////////////////////////////////////////////////////////////////////////
 
 server::httpServer::~httpServer()
 {
+    for(server::connection *idleConn : this->idleConnections)
+    {
+        delete idleConn;
+    }
+    this->idleConnections.clear();
+    for(packet::httpResponse *idleResponse : this->idleResponses)
+    {
+        delete idleResponse;
+    }
+    this->idleResponses.clear();
+    for(packet::httpRequest *idleRequest : this->idleRequests)
+    {
+        delete idleRequest;
+    }
+    this->idleRequests.clear();
+    if(this->routes != nullptr)
+    {
+        delete this->routes;
+        this->routes = nullptr;
+    }
     delete this->rootResource;
     this->rootResource = nullptr;
+    if(this->cryptoPool != nullptr)
+    {
+        delete this->cryptoPool;
+        this->cryptoPool = nullptr;
+    }
+    if(this->streamWorkers != nullptr)
+    {
+        delete this->streamWorkers;
+        this->streamWorkers = nullptr;
+    }
+    if(this->tickets != nullptr)
+    {
+        delete this->tickets;
+        this->tickets = nullptr;
+    }
+    if(this->cache != nullptr)
+    {
+        delete this->cache;
+        this->cache = nullptr;
+    }
+    if(this->memory != nullptr)
+    {
+        delete this->memory;
+        this->memory = nullptr;
+    }
+    if(this->accessLogger != nullptr)
+    {
+        delete this->accessLogger;
+        this->accessLogger = nullptr;
+    }
+    if(this->metrics != nullptr)
+    {
+        delete this->metrics;
+        this->metrics = nullptr;
+    }
 }
\ No newline at end of file
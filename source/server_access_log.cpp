@@ -0,0 +1,608 @@
+//
+// server_access_log.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <arpa/inet.h>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/server_access_log.hpp"
+#include "../headers/server_enum.hpp"
+#include "../headers/utility_clock.hpp"
+
+namespace enums = frederick2::httpEnums;
+namespace server = frederick2::httpServer;
+namespace utility = frederick2::utility;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+thread_local server::accessLog::ringLease server::accessLog::localLease;
+
+// method names, indexed by httpMethod; the converter maps are not safe to read concurrently
+static constexpr const char *logMethodNames[]{"-", "CONNECT", "DELETE", "GET", "HEAD", "OPTIONS", "PATCH", "POST", "PUT", "TRACE"};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::ring member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+server::accessLog::ring::ring()
+{
+    this->head.store(0, std::memory_order_relaxed);
+    this->tail.store(0, std::memory_order_relaxed);
+    this->dropped.store(0, std::memory_order_relaxed);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::ringLease member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void server::accessLog::ringLease::release()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // entries still in the ring stay there for the writer; the next thread
+    // to lease it carries on from the same head
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->pool != nullptr && this->local != nullptr)
+    {
+        std::lock_guard<std::mutex> poolGuard{this->pool->poolLock};
+        this->pool->freeRings.push_back(this->local);
+    }
+    this->local = nullptr;
+    this->pool.reset();
+}
+
+server::accessLog::ringLease::~ringLease()
+{
+    this->release();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::accessLog::accessLog(const std::string& logPath, const std::string& logFormat, size_t rotateBytes, size_t rotateKeep)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // entries carry cycleClock ticks; wall time is worked out by the writer
+    // from this one pairing, so request threads never read the system clock
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->fileDescriptor = -1;
+    this->fileBytes = 0;
+    this->maxBytes = rotateBytes;
+    this->keepFiles = rotateKeep;
+    this->filePath = logPath;
+    this->tokens = server::accessLog::parseFormat(logFormat);
+    this->baseTicks = utility::cycleClock::now();
+    this->baseWall = std::chrono::system_clock::now();
+    this->pool = std::make_shared<ringPool>();
+    this->stopping = false;
+    if(this->openFile(false))
+    {
+        this->writer = std::thread(&server::accessLog::writerLoop, this);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::appendEntry
+///////////////////////////////////////////////////////////////////////////////
+
+void server::accessLog::appendEntry(std::string& outString, const logEntry& curEntry, double tickSeconds)
+{
+    char numberBuffer[24];
+    auto appendUnsigned{[&](uint64_t curValue){
+        std::to_chars_result numberResult{std::to_chars(numberBuffer, numberBuffer + sizeof(numberBuffer), curValue)};
+        outString.append(numberBuffer, static_cast<size_t>(numberResult.ptr - numberBuffer));
+    }};
+
+    for(const formatToken& curToken : this->tokens)
+    {
+        switch(curToken.field)
+        {
+            case enums::logField::LITERAL:
+                outString.append(curToken.literal);
+                break;
+            case enums::logField::BYTES_IN:
+                appendUnsigned(curEntry.bytesIn);
+                break;
+            case enums::logField::BYTES_OUT:
+                appendUnsigned(curEntry.bytesOut);
+                break;
+            case enums::logField::HANDLER_TIME:
+                appendUnsigned(static_cast<uint64_t>(static_cast<double>(curEntry.handlerTicks) * tickSeconds * 1e6));
+                break;
+            case enums::logField::METHOD:
+            {
+                size_t methodIndex{static_cast<size_t>(curEntry.method)};
+                outString.append(methodIndex < std::size(logMethodNames) ? logMethodNames[methodIndex] : "-");
+                break;
+            }
+            case enums::logField::PEER:
+            {
+                char peerBuffer[INET6_ADDRSTRLEN];
+                if(curEntry.peerFamily != 0 && inet_ntop(curEntry.peerFamily, curEntry.peerAddress.data(), peerBuffer, sizeof(peerBuffer)) != nullptr)
+                {
+                    outString.append(peerBuffer);
+                }
+                else
+                {
+                    outString.append("-");
+                }
+                break;
+            }
+            case enums::logField::ROUTE:
+                if(curEntry.routeLength > 0)
+                {
+                    outString.append(curEntry.route.data(), curEntry.routeLength);
+                }
+                else
+                {
+                    outString.append("-");
+                }
+                break;
+            case enums::logField::STATUS:
+                appendUnsigned(curEntry.status);
+                break;
+            case enums::logField::TIME:
+            case enums::logField::TIME_ISO:
+            {
+                ///////////////////////////////////////////////////////////////////////////////
+                // finish time in UTC: [10/Oct/2020:13:55:36 +0000] for %t,
+                // 2020-10-10T13:55:36.123Z for %T
+                ///////////////////////////////////////////////////////////////////////////////
+
+                double sinceBase{curEntry.finishTicks > this->baseTicks ? static_cast<double>(curEntry.finishTicks - this->baseTicks) * tickSeconds : 0};
+                std::chrono::system_clock::time_point finishWall{this->baseWall + std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::duration<double>(sinceBase))};
+                std::time_t finishSeconds{std::chrono::system_clock::to_time_t(finishWall)};
+                std::tm finishParts;
+                gmtime_r(&finishSeconds, &finishParts);
+                char timeBuffer[40];
+                if(curToken.field == enums::logField::TIME)
+                {
+                    size_t timeLength{std::strftime(timeBuffer, sizeof(timeBuffer), "[%d/%b/%Y:%H:%M:%S +0000]", &finishParts)};
+                    outString.append(timeBuffer, timeLength);
+                }
+                else
+                {
+                    size_t timeLength{std::strftime(timeBuffer, sizeof(timeBuffer), "%Y-%m-%dT%H:%M:%S", &finishParts)};
+                    outString.append(timeBuffer, timeLength);
+                    int64_t finishMillis{std::chrono::duration_cast<std::chrono::milliseconds>(finishWall.time_since_epoch()).count() % 1000};
+                    std::snprintf(timeBuffer, sizeof(timeBuffer), ".%03dZ", static_cast<int>(finishMillis));
+                    outString.append(timeBuffer);
+                }
+                break;
+            }
+            case enums::logField::TOTAL_TIME:
+                appendUnsigned(static_cast<uint64_t>(static_cast<double>(curEntry.totalTicks) * tickSeconds * 1e6));
+                break;
+        }
+    }
+    outString.push_back('\n');
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::copyPeer
+///////////////////////////////////////////////////////////////////////////////
+
+void server::accessLog::copyPeer(logEntry& newEntry, const struct sockaddr *peerAddress)
+{
+    newEntry.peerFamily = 0;
+    newEntry.peerPort = 0;
+    if(peerAddress == nullptr)
+    {
+        return;
+    }
+    if(peerAddress->sa_family == AF_INET)
+    {
+        const struct sockaddr_in *peerV4{reinterpret_cast<const struct sockaddr_in*>(peerAddress)};
+        std::memcpy(newEntry.peerAddress.data(), &peerV4->sin_addr, sizeof(peerV4->sin_addr));
+        newEntry.peerPort = ntohs(peerV4->sin_port);
+        newEntry.peerFamily = AF_INET;
+    }
+    else if(peerAddress->sa_family == AF_INET6)
+    {
+        const struct sockaddr_in6 *peerV6{reinterpret_cast<const struct sockaddr_in6*>(peerAddress)};
+        std::memcpy(newEntry.peerAddress.data(), &peerV6->sin6_addr, sizeof(peerV6->sin6_addr));
+        newEntry.peerPort = ntohs(peerV6->sin6_port);
+        newEntry.peerFamily = AF_INET6;
+    }
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::drain
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::accessLog::drain(std::string& outString)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // the writer is the only consumer of every ring.  entries are formatted
+    // in place and the tail only moves past them afterwards, so a producer
+    // can never overwrite one that is still being read
+    ///////////////////////////////////////////////////////////////////////////////
+
+    {
+        std::lock_guard<std::mutex> poolGuard{this->pool->poolLock};
+        this->drainRings.clear();
+        for(const std::unique_ptr<ring>& curRing : this->pool->rings)
+        {
+            this->drainRings.push_back(curRing.get());
+        }
+    }
+
+    double tickSeconds{utility::cycleClock::secondsPerTick()};
+    size_t entryCount{0};
+    for(ring *curRing : this->drainRings)
+    {
+        uint64_t ringTail{curRing->tail.load(std::memory_order_relaxed)};
+        uint64_t ringHead{curRing->head.load(std::memory_order_acquire)};
+        while(ringTail != ringHead)
+        {
+            this->appendEntry(outString, curRing->entries[ringTail % server::accessLog::ringCapacity], tickSeconds);
+            ringTail++;
+            entryCount++;
+            if(outString.size() >= server::accessLog::batchLimit)
+            {
+                curRing->tail.store(ringTail, std::memory_order_release);
+                this->writeBatch(outString);
+            }
+        }
+        curRing->tail.store(ringTail, std::memory_order_release);
+    }
+    return(entryCount);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::getDropped
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::accessLog::getDropped()
+{
+    size_t droppedTotal{0};
+    std::lock_guard<std::mutex> poolGuard{this->pool->poolLock};
+    for(const std::unique_ptr<ring>& curRing : this->pool->rings)
+    {
+        droppedTotal += curRing->dropped.load(std::memory_order_relaxed);
+    }
+    return(droppedTotal);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::isOpen
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::accessLog::isOpen()
+{
+    return(this->fileDescriptor >= 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::localRing
+///////////////////////////////////////////////////////////////////////////////
+
+server::accessLog::ring* server::accessLog::localRing()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // one producer per ring: each thread leases its own and hands it back
+    // on exit, so per connection threads reuse rings instead of piling
+    // them up.  the pool lock is only taken on a thread's first entry
+    ///////////////////////////////////////////////////////////////////////////////
+
+    ringLease& lease{server::accessLog::localLease};
+    if(lease.pool == this->pool)
+    {
+        return(lease.local);
+    }
+
+    lease.release();
+    lease.pool = this->pool;
+    std::lock_guard<std::mutex> poolGuard{this->pool->poolLock};
+    if(this->pool->freeRings.empty())
+    {
+        std::unique_ptr<ring> newRing{new ring()};
+        lease.local = newRing.get();
+        this->pool->rings.push_back(std::move(newRing));
+    }
+    else
+    {
+        lease.local = this->pool->freeRings.back();
+        this->pool->freeRings.pop_back();
+    }
+    return(lease.local);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::openFile
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::accessLog::openFile(bool truncateFile)
+{
+    int openFlags{O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC};
+    if(truncateFile)
+    {
+        openFlags |= O_TRUNC;
+    }
+    this->fileDescriptor = ::open(this->filePath.c_str(), openFlags, 0644);
+    this->fileBytes = 0;
+    if(this->fileDescriptor < 0)
+    {
+        return(false);
+    }
+    struct stat fileStatus;
+    if(::fstat(this->fileDescriptor, &fileStatus) == 0)
+    {
+        this->fileBytes = static_cast<size_t>(fileStatus.st_size);
+    }
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::parseFormat
+///////////////////////////////////////////////////////////////////////////////
+
+std::vector<server::accessLog::formatToken> server::accessLog::parseFormat(const std::string& logFormat)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // %a peer, %t time [CLF], %T time ISO 8601, %m method, %r route,
+    // %s status, %I bytes in, %O bytes out, %D total microseconds,
+    // %H handler microseconds, %% percent.  anything else is literal
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::vector<formatToken> newTokens;
+    std::string pendingLiteral;
+    for(size_t index = 0; index < logFormat.size(); index++)
+    {
+        char curChar{logFormat[index]};
+        if(curChar != '%' || index + 1 >= logFormat.size())
+        {
+            pendingLiteral.push_back(curChar);
+            continue;
+        }
+
+        enums::logField curField{enums::logField::LITERAL};
+        switch(logFormat[index + 1])
+        {
+            case 'a':
+                curField = enums::logField::PEER;
+                break;
+            case 't':
+                curField = enums::logField::TIME;
+                break;
+            case 'T':
+                curField = enums::logField::TIME_ISO;
+                break;
+            case 'm':
+                curField = enums::logField::METHOD;
+                break;
+            case 'r':
+                curField = enums::logField::ROUTE;
+                break;
+            case 's':
+                curField = enums::logField::STATUS;
+                break;
+            case 'I':
+                curField = enums::logField::BYTES_IN;
+                break;
+            case 'O':
+                curField = enums::logField::BYTES_OUT;
+                break;
+            case 'D':
+                curField = enums::logField::TOTAL_TIME;
+                break;
+            case 'H':
+                curField = enums::logField::HANDLER_TIME;
+                break;
+            case '%':
+                pendingLiteral.push_back('%');
+                index++;
+                continue;
+            default:
+                pendingLiteral.push_back(curChar);
+                continue;
+        }
+        index++;
+        if(pendingLiteral.size() > 0)
+        {
+            newTokens.push_back(formatToken{enums::logField::LITERAL, std::move(pendingLiteral)});
+            pendingLiteral.clear();
+        }
+        newTokens.push_back(formatToken{curField, std::string()});
+    }
+    if(pendingLiteral.size() > 0)
+    {
+        newTokens.push_back(formatToken{enums::logField::LITERAL, std::move(pendingLiteral)});
+    }
+    return(newTokens);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::push
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::accessLog::push(const logEntry& newEntry)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // request path: a copy into this thread's ring and one release store.
+    // when the writer has fallen a full ring behind the entry is dropped
+    // and counted rather than making the request wait
+    ///////////////////////////////////////////////////////////////////////////////
+
+    ring *local{this->localRing()};
+    uint64_t ringHead{local->head.load(std::memory_order_relaxed)};
+    if(ringHead - local->tail.load(std::memory_order_acquire) >= server::accessLog::ringCapacity)
+    {
+        local->dropped.store(local->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return(false);
+    }
+    local->entries[ringHead % server::accessLog::ringCapacity] = newEntry;
+    local->head.store(ringHead + 1, std::memory_order_release);
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::rotate
+///////////////////////////////////////////////////////////////////////////////
+
+void server::accessLog::rotate()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // path -> path.1 -> path.2 ... up to keepFiles, the oldest falling off.
+    // with keepFiles at 0 the file is simply truncated
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->fileDescriptor >= 0)
+    {
+        ::close(this->fileDescriptor);
+        this->fileDescriptor = -1;
+    }
+    if(this->keepFiles == 0)
+    {
+        this->openFile(true);
+        return;
+    }
+    for(size_t index = this->keepFiles - 1; index > 0; index--)
+    {
+        std::string olderPath{this->filePath + "." + std::to_string(index)};
+        std::string newerPath{this->filePath + "." + std::to_string(index + 1)};
+        ::rename(olderPath.c_str(), newerPath.c_str());
+    }
+    std::string firstPath{this->filePath + ".1"};
+    ::rename(this->filePath.c_str(), firstPath.c_str());
+    this->openFile(false);
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::writeBatch
+///////////////////////////////////////////////////////////////////////////////
+
+void server::accessLog::writeBatch(std::string& outString)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // one write per batch; O_APPEND keeps lines whole even if something
+    // else appends to the same file.  a batch that cannot be written is
+    // discarded rather than held, so a full disk cannot stall the writer
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->maxBytes > 0 && this->fileBytes > 0 && this->fileBytes + outString.size() > this->maxBytes)
+    {
+        this->rotate();
+    }
+
+    size_t bytesWritten{0};
+    while(this->fileDescriptor >= 0 && bytesWritten < outString.size())
+    {
+        ssize_t writeResult{::write(this->fileDescriptor, outString.data() + bytesWritten, outString.size() - bytesWritten)};
+        if(writeResult < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        bytesWritten += static_cast<size_t>(writeResult);
+    }
+    this->fileBytes += bytesWritten;
+    outString.clear();
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::accessLog::writerLoop
+///////////////////////////////////////////////////////////////////////////////
+
+void server::accessLog::writerLoop()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // sweeps every ring, formats what it finds and writes it as one batch,
+    // then naps briefly when there was nothing to do.  the stop flag is
+    // read before the sweep so the last sweep catches everything pushed
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string outString;
+    outString.reserve(server::accessLog::batchLimit + 4096);
+    while(true)
+    {
+        bool stopNow{this->stopping.load(std::memory_order_acquire)};
+        size_t entryCount{this->drain(outString)};
+        if(outString.size() > 0)
+        {
+            this->writeBatch(outString);
+        }
+        if(stopNow)
+        {
+            break;
+        }
+        if(entryCount == 0)
+        {
+            std::unique_lock<std::mutex> wakeGuard{this->wakeLock};
+            this->wakeWriter.wait_for(wakeGuard, std::chrono::milliseconds(10), [this](){ return(this->stopping.load()); });
+        }
+    }
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::accessLog::~accessLog()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // the writer drains once more after seeing the flag, so everything
+    // pushed before this point reaches the file.  threads still leasing a
+    // ring hold the pool alive and return their ring to it on exit
+    ///////////////////////////////////////////////////////////////////////////////
+
+    {
+        std::lock_guard<std::mutex> wakeGuard{this->wakeLock};
+        this->stopping = true;
+    }
+    this->wakeWriter.notify_all();
+    if(this->writer.joinable())
+    {
+        this->writer.join();
+    }
+    if(this->fileDescriptor >= 0)
+    {
+        ::close(this->fileDescriptor);
+        this->fileDescriptor = -1;
+    }
+}
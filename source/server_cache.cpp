@@ -0,0 +1,350 @@
+//
+// server_cache.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/server_cache.hpp"
+#include "../headers/utility_parse.hpp"
+
+namespace server = frederick2::httpServer;
+namespace utility = frederick2::utility;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::responseCache member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::responseCache::responseCache(size_t maxBytes)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // one shard per hardware thread (rounded up to a power of 2)
+    // so concurrent lookups rarely contend on the same mutex
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t hwThreads{std::thread::hardware_concurrency()};
+    size_t shardCount{1};
+    while(shardCount < hwThreads && shardCount < 64)
+    {
+        shardCount <<= 1;
+    }
+
+    this->shardMask = shardCount - 1;
+    this->shardBudget = maxBytes / shardCount;
+    for(size_t index = 0; index < shardCount; index++)
+    {
+        std::unique_ptr<cacheShard> newShard{new cacheShard()};
+        newShard->bytes = 0;
+        this->shards.push_back(std::move(newShard));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::responseCache::buildETag
+///////////////////////////////////////////////////////////////////////////////
+
+std::string server::responseCache::buildETag(const std::string& content)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // strong validator from a 64bit FNV-1a hash of the response body
+    ///////////////////////////////////////////////////////////////////////////////
+
+    uint64_t hashValue{14695981039346656037ULL};
+    for(size_t index = 0; index < content.size(); index++)
+    {
+        hashValue ^= static_cast<unsigned char>(content[index]);
+        hashValue *= 1099511628211ULL;
+    }
+
+    utility::parseUtilities parseUtil;
+    std::string hexString;
+    parseUtil.toHex(hashValue, hexString);
+
+    std::string returnString{"\""};
+    returnString.append(hexString);
+    returnString.append("\"");
+    return(returnString);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::responseCache::fetch
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::responseCache::fetch
+(const std::string& key, std::shared_ptr<const std::string>& payload, size_t& headLength, std::string& etag, std::string& vary, std::string& cacheControl, long& entryAge)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // entryAge is whole seconds since the entry was stored, for comparing
+    // against a request's max-age
+    ///////////////////////////////////////////////////////////////////////////////
+
+    cacheShard *targetShard{this->getShard(key)};
+    std::lock_guard<std::mutex> shardLock(targetShard->lock);
+
+    auto search{targetShard->index.find(key)};
+    if(search == targetShard->index.end())
+    {
+        return(false);
+    }
+
+    entryLIST::iterator entryIter{search->second};
+    std::chrono::steady_clock::time_point fetchTime{std::chrono::steady_clock::now()};
+    if(entryIter->expires < fetchTime)
+    {
+        targetShard->bytes -= entryIter->bytes;
+        targetShard->index.erase(search);
+        targetShard->lru.erase(entryIter);
+        return(false);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // move entry to the front of the LRU list
+    // payload is shared so the copy out of the lock is just a refcount bump
+    ///////////////////////////////////////////////////////////////////////////////
+
+    targetShard->lru.splice(targetShard->lru.begin(), targetShard->lru, entryIter);
+    payload = entryIter->payload;
+    headLength = entryIter->headLength;
+    etag = entryIter->etag;
+    vary = entryIter->vary;
+    cacheControl = entryIter->cacheControl;
+    entryAge = std::chrono::duration_cast<std::chrono::seconds>(fetchTime - entryIter->stored).count();
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::responseCache::getShard
+///////////////////////////////////////////////////////////////////////////////
+
+server::responseCache::cacheShard *server::responseCache::getShard(const std::string& key)
+{
+    size_t shardIndex{std::hash<std::string>{}(key) & this->shardMask};
+    return(this->shards[shardIndex].get());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::responseCache::matchETag
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::responseCache::matchETag(std::string_view ifNoneMatch, std::string_view etag)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // If-None-Match uses the weak comparison function (RFC7232 [3.2])
+    // so W/ prefixes are ignored on both sides
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string_view wspChars{" \t"};
+    std::string_view targetTag{etag};
+    if(targetTag.compare(0, 2, "W/") == 0)
+    {
+        targetTag.remove_prefix(2);
+    }
+
+    size_t startPos{0};
+    while(startPos < ifNoneMatch.size())
+    {
+        size_t commaFound{ifNoneMatch.find_first_of(',', startPos)};
+        if(commaFound == std::string_view::npos)
+        {
+            commaFound = ifNoneMatch.size();
+        }
+        std::string_view candidate{ifNoneMatch.substr(startPos, commaFound - startPos)};
+        startPos = commaFound + 1;
+
+        size_t firstFound{candidate.find_first_not_of(wspChars)};
+        if(firstFound == std::string_view::npos)
+        {
+            continue;
+        }
+        size_t lastFound{candidate.find_last_not_of(wspChars)};
+        candidate = candidate.substr(firstFound, (lastFound - firstFound) + 1);
+        if(candidate == "*")
+        {
+            return(true);
+        }
+        if(candidate.compare(0, 2, "W/") == 0)
+        {
+            candidate.remove_prefix(2);
+        }
+        if(candidate == targetTag)
+        {
+            return(true);
+        }
+    }
+
+    return(false);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::responseCache::parseCacheControl
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::responseCache::parseCacheControl
+(const std::string& headerValue, bool& noStore, bool& noCache, long& maxAge)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // private is treated as no-store since this is a shared cache
+    // s-maxage takes precedence over max-age (RFC7234 [5.2.2.9])
+    ///////////////////////////////////////////////////////////////////////////////
+
+    utility::parseUtilities parseUtil;
+    std::string wspChars{" \t"};
+    std::string workingStr;
+    parseUtil.toLower(headerValue, workingStr);
+
+    bool hasSharedMaxAge{false};
+    noStore = false;
+    noCache = false;
+    maxAge = -1;
+
+    size_t startPos{0};
+    while(startPos < workingStr.size())
+    {
+        size_t commaFound{workingStr.find_first_of(',', startPos)};
+        if(commaFound == std::string::npos)
+        {
+            commaFound = workingStr.size();
+        }
+        std::string directive{workingStr.substr(startPos, commaFound - startPos)};
+        startPos = commaFound + 1;
+
+        size_t firstFound{directive.find_first_not_of(wspChars)};
+        if(firstFound == std::string::npos)
+        {
+            continue;
+        }
+        size_t lastFound{directive.find_last_not_of(wspChars)};
+        directive = directive.substr(firstFound, (lastFound - firstFound) + 1);
+
+        std::string directiveValue;
+        size_t eqFound{directive.find_first_of('=')};
+        if(eqFound != std::string::npos)
+        {
+            directiveValue = directive.substr(eqFound + 1);
+            directive.erase(eqFound);
+        }
+
+        if(directive == "no-store" || directive == "private")
+        {
+            noStore = true;
+        }
+        else if(directive == "no-cache")
+        {
+            noCache = true;
+        }
+        else if(directive == "max-age" || directive == "s-maxage")
+        {
+            long ageValue{-1};
+            try
+            {
+                ageValue = std::stol(directiveValue);
+            }
+            catch(const std::exception& e)
+            {
+                return(false);
+            }
+            if(directive == "s-maxage")
+            {
+                hasSharedMaxAge = true;
+                maxAge = ageValue;
+            }
+            else if(!hasSharedMaxAge)
+            {
+                maxAge = ageValue;
+            }
+        }
+    }
+
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::responseCache::store
+///////////////////////////////////////////////////////////////////////////////
+
+void server::responseCache::store
+(const std::string& key, std::string&& serialized, size_t headLength, const std::string& etag, const std::string& vary, const std::string& cacheControl, size_t ttl)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // Vary and Cache-Control are kept beside the ETag because a 304 must
+    // repeat them (RFC 7232 4.1) and the serialized head is not reparsed
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t entryBytes{serialized.size() + key.size() + etag.size() + vary.size() + cacheControl.size()};
+    if(ttl == 0 || entryBytes > this->shardBudget)
+    {
+        return;
+    }
+
+    cacheEntry newEntry;
+    newEntry.key = key;
+    newEntry.etag = etag;
+    newEntry.vary = vary;
+    newEntry.cacheControl = cacheControl;
+    newEntry.payload = std::make_shared<const std::string>(std::move(serialized));
+    newEntry.headLength = headLength;
+    newEntry.bytes = entryBytes;
+    newEntry.stored = std::chrono::steady_clock::now();
+    newEntry.expires = newEntry.stored + std::chrono::seconds(ttl);
+
+    cacheShard *targetShard{this->getShard(key)};
+    std::lock_guard<std::mutex> shardLock(targetShard->lock);
+
+    auto search{targetShard->index.find(key)};
+    if(search != targetShard->index.end())
+    {
+        targetShard->bytes -= search->second->bytes;
+        targetShard->lru.erase(search->second);
+        targetShard->index.erase(search);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // evict least recently used entries until the new entry fits
+    ///////////////////////////////////////////////////////////////////////////////
+
+    while(targetShard->bytes + entryBytes > this->shardBudget && targetShard->lru.size() > 0)
+    {
+        cacheEntry& lastEntry{targetShard->lru.back()};
+        targetShard->bytes -= lastEntry.bytes;
+        targetShard->index.erase(lastEntry.key);
+        targetShard->lru.pop_back();
+    }
+
+    targetShard->lru.push_front(std::move(newEntry));
+    targetShard->index[key] = targetShard->lru.begin();
+    targetShard->bytes += entryBytes;
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::responseCache::~responseCache()
+{
+    this->shards.clear();
+}
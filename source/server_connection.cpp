@@ -7,9 +7,13 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <chrono>
 #include <errno.h>
 #include <exception>
+#include <fcntl.h>
 #include <future>
 #include <memory>
 #include <netinet/in.h>
@@ -17,21 +21,32 @@
 #include <openssl/bio.h>
 #include <openssl/err.h>
 #include <openssl/ssl.h>
+#include <poll.h>
 #include <string>
+#include <string_view>
+#include <sys/sendfile.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <thread>
 #include <unistd.h>
 #include <vector>
 
 #include "../headers/frederick2_namespace.hpp"
 #include "../headers/http_request.hpp"
 #include "../headers/http_response.hpp"
+#include "../headers/parse_header_line.hpp"
 #include "../headers/server_connection.hpp"
 #include "../headers/server_enum.hpp"
+#include "../headers/server_handshake.hpp"
+#include "../headers/server_http2.hpp"
+#include "../headers/server_memory.hpp"
+#include "../headers/server_metrics.hpp"
+#include "../headers/utility_clock.hpp"
 
 namespace enums = frederick2::httpEnums;
 namespace packet = frederick2::httpPacket;
 namespace server = frederick2::httpServer;
+namespace utility = frederick2::utility;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // global variable definitions
@@ -50,15 +65,14 @@ namespace server = frederick2::httpServer;
 ///////////////////////////////////////////////////////////////////////////////
 
 server::connection::connection(server::httpServer *hostServer)
+    : probeParser{&probeBuffer}
 {
-    this->connectionError = false;
     this->host = hostServer;
-    this->maxTime = 30;
+    this->memoryHeld = 0;
+    this->ioBuffer.resize(16384);
     this->sock = nullptr;
-    this->sslActive = false;
-    this->sslContext = nullptr;
     this->sslConnection = nullptr;
-    this->useSSL = false;    
+    this->reset();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -69,7 +83,9 @@ bool server::connection::acceptConnection(int sockFD)
 {
     bool returnValue{false};
     ERR_clear_error();
+    this->addressLength = sizeof(this->address);
     this->sock = new server::socket(::accept(sockFD, &this->address, &this->addressLength));
+    this->acceptTicks = utility::cycleClock::now();
     if (this->sock->getFD() > 0)
     {
         size_t optval{1};
@@ -82,17 +98,18 @@ bool server::connection::acceptConnection(int sockFD)
 
         if(this->useSSL)
         {
+            ///////////////////////////////////////////////////////////////////////////////
+            // handshake is driven later on the connection's own thread
+            // so a slow client never holds up the accept loop
+            ///////////////////////////////////////////////////////////////////////////////
+
             this->sslConnection = SSL_new(this->sslContext);
-            SSL_set_fd(this->sslConnection, this->sock->getFD());
-            
-            auto sslError = SSL_accept(this->sslConnection);
-            if(sslError <= 0)
+            if(this->sslConnection == nullptr)
             {
-                auto sslErrorDesc{SSL_get_error(this->sslConnection, sslError)};
-                this->shutdownSSLConnection();
-                returnValue = false;
+                return(false);
             }
-            this->sslActive = true;
+            SSL_set_fd(this->sslConnection, this->sock->getFD());
+            SSL_set_accept_state(this->sslConnection);
         }
     }
     return(returnValue);
@@ -107,27 +124,104 @@ void server::connection::close()
     this->sock->close();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::connection::detectHTTP2
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::connection::detectHTTP2()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // TLS clients pick h2 through ALPN.  cleartext clients with prior
+    // knowledge open with the connection preface, which is sniffed here;
+    // anything read is left in receiveBuffer for whichever protocol runs
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(!this->useHTTP2)
+    {
+        return(false);
+    }
+    if(this->sslActive)
+    {
+        const unsigned char *protocol{nullptr};
+        unsigned int protocolLength{0};
+        SSL_get0_alpn_selected(this->sslConnection, &protocol, &protocolLength);
+        return(protocolLength == 2 && protocol[0] == 'h' && protocol[1] == '2');
+    }
+
+    const std::string clientPreface{"PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"};
+    auto deadline{std::chrono::steady_clock::now() + std::chrono::seconds(this->maxTime)};
+    while(!this->connectionError && std::chrono::steady_clock::now() < deadline)
+    {
+        size_t compareLength{std::min(this->receiveBuffer.size(), clientPreface.size())};
+        if(this->receiveBuffer.compare(0, compareLength, clientPreface, 0, compareLength) != 0)
+        {
+            return(false);
+        }
+        if(compareLength == clientPreface.size())
+        {
+            return(true);
+        }
+        struct pollfd prefacePoll{this->sock->getFD(), POLLIN, 0};
+        if(poll(&prefacePoll, 1, 50) > 0)
+        {
+            this->readData();
+        }
+    }
+    return(false);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::connection::handleConnection()
 ///////////////////////////////////////////////////////////////////////////////
 
 bool server::connection::handleConnection(std::future<void> exitSignal)
 {   
+    ///////////////////////////////////////////////////////////////////////////////
+    // queue and tls are per connection; every request after that is timed
+    // from its first byte to its last and recorded against its route
+    ///////////////////////////////////////////////////////////////////////////////
+
+    const std::array<size_t, server::httpServer::stageCount>& connectionStages{this->host->metricIDs.unroutedStages};
+    uint64_t stageStart{utility::cycleClock::now()};
+    this->host->metrics->observeTicks(connectionStages[static_cast<size_t>(enums::latencyStage::QUEUE)], stageStart > this->acceptTicks ? stageStart - this->acceptTicks : 0);
+
+    if(this->useSSL)
+    {
+        bool handshakeDone{this->handshakeSSL()};
+        uint64_t stageEnd{utility::cycleClock::now()};
+        this->host->metrics->observeTicks(connectionStages[static_cast<size_t>(enums::latencyStage::TLS)], stageEnd > stageStart ? stageEnd - stageStart : 0);
+        if(!handshakeDone)
+        {
+            this->sock->shutdown(true, true);
+            this->sock->close();
+            return(true);
+        }
+    }
+
+    bool spokeHTTP2{false};
+    if(this->detectHTTP2())
+    {
+        std::unique_ptr<server::http2Session> session{new server::http2Session(this, this->host)};
+        session->run(exitSignal);
+        spokeHTTP2 = true;
+    }
+
     auto startTime{std::chrono::steady_clock::now()};
     auto curTime{std::chrono::steady_clock::now()};
     bool clockRunning{false};
     size_t maxTimeMills{this->maxTime * 1000};
     auto signalStatus{exitSignal.wait_for(std::chrono::milliseconds(0))};    
-    while(signalStatus != std::future_status::ready && !this->connectionError)
+    while(signalStatus != std::future_status::ready && !this->connectionError && !spokeHTTP2)
     {
-        if(this->sock->pollIn())
+        if(this->receiveBuffer.size() > 0 || this->sock->pollIn())
         {   
             clockRunning = false;
-            packet::httpRequest *request{new packet::httpRequest(&this->receiveBuffer)};
-            auto buildFuncPtr{&packet::httpRequest::buildRequest};
-            std::future<bool> buildFuture{std::async(std::launch::async, buildFuncPtr, request)};
-            auto buildStatus{buildFuture.wait_for(std::chrono::milliseconds(0))};    
-            while(buildStatus != std::future_status::ready && !this->connectionError)
+            packet::httpRequest *request{this->host->acquireRequest(&this->receiveBuffer)};
+            request->memory = this->host->memory;
+            request->stages.firstByte = utility::cycleClock::now();
+            bool buildGet{false};
+            bool buildInline{this->requestBuffered()};
+            if(!buildInline)
             {
                 if(this->sslActive)
                 {
@@ -137,18 +231,51 @@ bool server::connection::handleConnection(std::future<void> exitSignal)
                 {
                     this->readData();
                 }
-                buildStatus = buildFuture.wait_for(std::chrono::milliseconds(0));
+                buildInline = !this->connectionError && this->requestBuffered();
+            }
+            if(buildInline)
+            {
+                ///////////////////////////////////////////////////////////////////////////////
+                // everything the parser needs is already here, so it runs
+                // inline instead of on a reader thread of its own
+                ///////////////////////////////////////////////////////////////////////////////
+
+                buildGet = request->buildRequest();
+            }
+            else
+            {
+                auto buildFuncPtr{&packet::httpRequest::buildRequest};
+                std::future<bool> buildFuture{std::async(std::launch::async, buildFuncPtr, request)};
+                auto buildStatus{buildFuture.wait_for(std::chrono::milliseconds(0))};    
+                while(buildStatus != std::future_status::ready && !this->connectionError)
+                {
+                    if(this->sslActive)
+                    {
+                        this->readDataSSL();
+                    }
+                    else
+                    {
+                        this->readData();
+                    }
+                    buildStatus = buildFuture.wait_for(std::chrono::milliseconds(0));
+                }
+                if(!this->connectionError)
+                {
+                    buildGet = buildFuture.get();
+                }
             }
             if(!this->connectionError)
             {
-                bool buildGet{buildFuture.get()};
                 if(!buildGet)
                 {
                     throw std::runtime_error("wtf: packet::httpRequest::buildRequest returned false");
                 }
                 
-                packet::httpResponse *response{this->host->handleRequest(request)};
+                bool zeroCopy{!this->sslActive || this->ktlsSend};
+                packet::httpResponse *response{this->host->handleRequest(request, zeroCopy)};
                 std::string outString{response->toString()};
+                this->holdMemory(this->memoryHeld + outString.size());
+                size_t bytesSent{outString.size()};
 
                 if(this->sslActive)
                 {
@@ -158,17 +285,35 @@ bool server::connection::handleConnection(std::future<void> exitSignal)
                 {
                     this->sendData(std::move(outString));
                 }
+
+                int fileDescriptor{-1};
+                size_t fileLength{0};
+                if(!this->connectionError && response->getContentFile(fileDescriptor, fileLength))
+                {
+                    this->sendFile(fileDescriptor, fileLength);
+                    bytesSent += fileLength;
+                }
+                this->host->metrics->add(this->host->metricIDs.bytesOut, static_cast<int64_t>(bytesSent));
+                uint64_t lastByte{utility::cycleClock::now()};
+                this->host->recordStages(request, lastByte);
+                this->host->logAccess(request, &this->address, bytesSent, lastByte);
                 
                 bool closeConn{response->getHeader("Connection") == "close"};
                 
-                delete request;
-                delete response;
+                this->host->releaseResponse(response);
+                this->host->releaseRequest(request);
+                this->holdMemory(this->receiveBuffer.size());
                 
                 if(closeConn)
                 {
                     break;
                 }
-            }                                   
+            }
+            else
+            {
+                this->host->releaseRequest(request);
+                this->holdMemory(this->receiveBuffer.size());
+            }
         }
         else
         {
@@ -184,6 +329,7 @@ bool server::connection::handleConnection(std::future<void> exitSignal)
                 if(std::chrono::duration_cast<std::chrono::milliseconds>(timeLapse).count() > maxTimeMills)
                 {
                     this->connectionError = true;
+                    this->host->metrics->increment(this->host->metricIDs.idleTimeouts);
                 }
             }
         }
@@ -206,24 +352,147 @@ bool server::connection::handleConnection(std::future<void> exitSignal)
     return(true);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::connection::handshakeSSL
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::connection::handshakeSSL()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // socket is non-blocking for the handshake only.  each WANT_READ / WANT_WRITE
+    // waits on poll for the remainder of the handshake deadline
+    ///////////////////////////////////////////////////////////////////////////////
+
+    int sockFD{this->sock->getFD()};
+    int sockFlags{fcntl(sockFD, F_GETFL, 0)};
+    fcntl(sockFD, F_SETFL, sockFlags | O_NONBLOCK);
+
+    auto deadline{std::chrono::steady_clock::now() + std::chrono::seconds(this->handshakeTime)};
+    bool returnValue{false};
+    while(true)
+    {
+        int handshakeResult{-1};
+        int sslError{SSL_ERROR_SSL};
+        if(this->cryptoPool != nullptr)
+        {
+            if(!this->cryptoPool->runStep(this->sslConnection, handshakeResult, sslError, deadline))
+            {
+                break;
+            }
+        }
+        else
+        {
+            ERR_clear_error();
+            handshakeResult = SSL_do_handshake(this->sslConnection);
+            if(handshakeResult != 1)
+            {
+                sslError = SSL_get_error(this->sslConnection, handshakeResult);
+            }
+        }
+        if(handshakeResult == 1)
+        {
+            returnValue = true;
+            break;
+        }
+
+        struct pollfd handshakePoll;
+        handshakePoll.fd = sockFD;
+        handshakePoll.revents = 0;
+        if(sslError == SSL_ERROR_WANT_READ)
+        {
+            handshakePoll.events = POLLIN;
+        }
+        else if(sslError == SSL_ERROR_WANT_WRITE)
+        {
+            handshakePoll.events = POLLOUT;
+        }
+        else
+        {
+            break;
+        }
+
+        auto remaining{std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now())};
+        if(remaining.count() <= 0)
+        {
+            break;
+        }
+        int pollResult{poll(&handshakePoll, 1, static_cast<int>(remaining.count()))};
+        if(pollResult < 0 && errno != EINTR)
+        {
+            break;
+        }
+        if(pollResult > 0 && (handshakePoll.revents & (POLLERR | POLLHUP | POLLNVAL)) && !(handshakePoll.revents & POLLIN))
+        {
+            break;
+        }
+    }
+
+    fcntl(sockFD, F_SETFL, sockFlags);
+
+    if(!returnValue)
+    {
+        SSL_free(this->sslConnection);
+        this->sslConnection = nullptr;
+        return(returnValue);
+    }
+
+    this->sslActive = true;
+    this->host->recordHandshake(SSL_session_reused(this->sslConnection) == 1);
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // kernel owns the send side when kTLS was negotiated
+    // file bodies can then bypass user space entirely
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->ktlsSend = BIO_get_ktls_send(SSL_get_wbio(this->sslConnection)) > 0;
+    return(returnValue);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::connection::holdMemory
+///////////////////////////////////////////////////////////////////////////////
+
+void server::connection::holdMemory(size_t heldBytes)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // reports this connection's whole footprint (buffered input, the body
+    // of the request in flight, and output waiting to be sent) to the
+    // server-wide governor
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->host->memory->adjust(this->memoryHeld, heldBytes);
+    this->memoryHeld = heldBytes;
+    return;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::connection::readData
 ///////////////////////////////////////////////////////////////////////////////
 
 void server::connection::readData()
 {
-    std::vector<char> rawBuffer(256);
+    ///////////////////////////////////////////////////////////////////////////////
+    // a paused connection leaves its input in the kernel so the client's
+    // TCP window closes; callers simply come back around to read again
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->host->memory->shouldPause(this->memoryHeld))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return;
+    }
     while(this->sock->pollIn())
     {
-        ssize_t bytesReceived{::recv(this->sock->getFD(), &rawBuffer[0], rawBuffer.capacity(), 0)};
+        ssize_t bytesReceived{::recv(this->sock->getFD(), this->ioBuffer.data(), this->ioBuffer.size(), 0)};
         if(bytesReceived > 0)
         {
-            this->receiveBuffer.append(&rawBuffer[0], bytesReceived);
-            rawBuffer.clear();                        
+            this->receiveBuffer.append(this->ioBuffer.data(), bytesReceived);
+            this->holdMemory(this->memoryHeld + bytesReceived);
         }
         else
         {
             this->connectionError = true;
+            break;
         }
     }
     return;
@@ -235,21 +504,34 @@ void server::connection::readData()
 
 void server::connection::readDataSSL()
 {
-    std::vector<char> rawBuffer(256);
-    if(this->sock->pollIn())
+    ///////////////////////////////////////////////////////////////////////////////
+    // ioBuffer holds a full 16KB TLS record so each SSL_read drains
+    // a whole record instead of slicing it into small copies
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->host->memory->shouldPause(this->memoryHeld))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return;
+    }
+    if(this->sock->pollIn() || SSL_pending(this->sslConnection) > 0)
     {
         do
         {
             ERR_clear_error();
-            ssize_t bytesReceived{SSL_read(this->sslConnection, &rawBuffer[0], rawBuffer.capacity())};
+            int bytesReceived{SSL_read(this->sslConnection, this->ioBuffer.data(), this->ioBuffer.size())};
             if(bytesReceived > 0)
             {
-                this->receiveBuffer.append(&rawBuffer[0], bytesReceived);
-                rawBuffer.clear();
+                this->receiveBuffer.append(this->ioBuffer.data(), bytesReceived);
+                this->holdMemory(this->memoryHeld + bytesReceived);
             }
             else
             {
-                this->connectionError = true;
+                int sslError{SSL_get_error(this->sslConnection, bytesReceived)};
+                if(sslError != SSL_ERROR_WANT_READ && sslError != SSL_ERROR_WANT_WRITE)
+                {
+                    this->connectionError = true;
+                }
                 break;
             }
         } while (SSL_pending(this->sslConnection) > 0);
@@ -257,6 +539,94 @@ void server::connection::readDataSSL()
     return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::connection::requestBuffered
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::connection::requestBuffered()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // true when receiveBuffer already holds the whole header block and any
+    // Content-Length body.  the header lines are copied to probeBuffer and
+    // split by the same headerLineParser the request parser uses, so names
+    // match exactly as they will there and only the first Content-Length
+    // counts, as in validateRequest.  a malformed line is left for the
+    // inline parse to reject; Transfer-Encoding goes to the reader thread
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t headerEnd{this->receiveBuffer.find("\r\n\r\n")};
+    if(headerEnd == std::string::npos)
+    {
+        return(false);
+    }
+    size_t linesStart{this->receiveBuffer.find("\r\n") + 2};
+    this->probeBuffer.assign(this->receiveBuffer, linesStart, (headerEnd + 2) - linesStart);
+
+    bool lengthFound{false};
+    size_t bodyLength{0};
+    while(this->probeBuffer.size() > 0)
+    {
+        if(this->probeParser.execute() != enums::httpStatus::OK)
+        {
+            this->probeBuffer.clear();
+            return(true);
+        }
+        const std::string& fieldName{this->probeParser.getFieldName()};
+        if(fieldName == "Transfer-Encoding")
+        {
+            this->probeBuffer.clear();
+            return(false);
+        }
+        if(fieldName == "Content-Length" && !lengthFound)
+        {
+            const std::string& fieldValue{this->probeParser.getFieldValueString()};
+            std::from_chars(fieldValue.data(), fieldValue.data() + fieldValue.size(), bodyLength);
+            lengthFound = true;
+        }
+    }
+
+    return(bodyLength <= this->receiveBuffer.size() - (headerEnd + 4));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::connection::reset
+///////////////////////////////////////////////////////////////////////////////
+
+void server::connection::reset()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // returns a finished connection to its constructed state for reuse.
+    // ioBuffer and the string buffers keep their allocations
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->sslConnection != nullptr)
+    {
+        SSL_free(this->sslConnection);
+        this->sslConnection = nullptr;
+    }
+    if(this->sock != nullptr)
+    {
+        delete this->sock;
+        this->sock = nullptr;
+    }
+    this->holdMemory(0);
+    this->connectionError = false;
+    this->cryptoPool = nullptr;
+    this->ktlsSend = false;
+    this->bytesSinceIdle = 0;
+    this->handshakeTime = 10;
+    this->maxTime = 30;
+    this->acceptTicks = 0;
+    this->sslActive = false;
+    this->sslContext = nullptr;
+    this->useHTTP2 = false;
+    this->useSSL = false;
+    this->receiveBuffer.clear();
+    this->sendBuffer.clear();
+    this->sslCertPath.clear();
+    this->sslKeyPath.clear();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::connection::sendData
 ///////////////////////////////////////////////////////////////////////////////
@@ -286,13 +656,105 @@ void server::connection::sendData(std::string sendBuffer)
 
 void server::connection::sendDataSSL(std::string sendBuffer)
 {
-    size_t buffSize{sendBuffer.size()};
-    ERR_clear_error();
-    ssize_t numSent{SSL_write(this->sslConnection, sendBuffer.c_str(), buffSize)};
-    if(numSent < 0)
+    ///////////////////////////////////////////////////////////////////////////////
+    // dynamic record sizing: while the connection is fresh (or has been idle)
+    // records are kept under one TCP segment so the client can decrypt the
+    // first bytes as soon as they arrive.  once enough has been sent that the
+    // congestion window is open, switch to maximum size records for throughput
+    ///////////////////////////////////////////////////////////////////////////////
+
+    auto curTime{std::chrono::steady_clock::now()};
+    if(curTime - this->lastSend > std::chrono::seconds(1))
     {
-        this->connectionError = true;
+        this->bytesSinceIdle = 0;
     }
+
+    const char *outCStr{sendBuffer.data()};
+    size_t outCStrLen{sendBuffer.size()};
+    while(outCStrLen > 0)
+    {
+        size_t recordSize{this->bytesSinceIdle < 1048576 ? 1400 : this->ioBuffer.size()};
+        size_t writeSize{outCStrLen < recordSize ? outCStrLen : recordSize};
+        ERR_clear_error();
+        int numSent{SSL_write(this->sslConnection, outCStr, writeSize)};
+        if(numSent <= 0)
+        {
+            int sslError{SSL_get_error(this->sslConnection, numSent)};
+            if(sslError == SSL_ERROR_WANT_WRITE || sslError == SSL_ERROR_WANT_READ)
+            {
+                continue;
+            }
+            this->connectionError = true;
+            break;
+        }
+        outCStr += numSent;
+        outCStrLen -= numSent;
+        this->bytesSinceIdle += numSent;
+    }
+
+    this->lastSend = std::chrono::steady_clock::now();
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::connection::sendFile
+///////////////////////////////////////////////////////////////////////////////
+
+void server::connection::sendFile(int fileDescriptor, size_t fileLength)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // page cache to socket without a user space copy.  with kTLS the kernel
+    // encrypts the records, otherwise the socket is plain TCP
+    ///////////////////////////////////////////////////////////////////////////////
+
+    off_t fileOffset{0};
+    while(static_cast<size_t>(fileOffset) < fileLength)
+    {
+        size_t remaining{fileLength - static_cast<size_t>(fileOffset)};
+        ssize_t numSent{-1};
+        if(this->sslActive)
+        {
+            ERR_clear_error();
+            numSent = SSL_sendfile(this->sslConnection, fileDescriptor, fileOffset, remaining, 0);
+            if(numSent > 0)
+            {
+                fileOffset += numSent;
+            }
+        }
+        else
+        {
+            numSent = ::sendfile(this->sock->getFD(), fileDescriptor, &fileOffset, remaining);
+        }
+        if(numSent <= 0)
+        {
+            if(numSent < 0 && !this->sslActive && (errno == EINTR || errno == EAGAIN))
+            {
+                continue;
+            }
+            this->connectionError = true;
+            break;
+        }
+    }
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::connection::setHandshakePool
+///////////////////////////////////////////////////////////////////////////////
+
+void server::connection::setHandshakePool(server::handshakePool *pool)
+{
+    this->cryptoPool = pool;
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::connection::setHandshakeTime
+///////////////////////////////////////////////////////////////////////////////
+
+void server::connection::setHandshakeTime(size_t timeout)
+{
+    this->handshakeTime = timeout;
     return;
 }
 
@@ -336,6 +798,16 @@ void server::connection::setSSLPublicCert(const std::string& certPath)
     return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::connection::setUseHTTP2
+///////////////////////////////////////////////////////////////////////////////
+
+void server::connection::setUseHTTP2(bool http2Flag)
+{
+    this->useHTTP2 = http2Flag;
+    return;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::connection::setUseSSL
 ///////////////////////////////////////////////////////////////////////////////
@@ -357,6 +829,7 @@ void server::connection::shutdownSSLConnection()
         SSL_shutdown(this->sslConnection);
     }
     SSL_free(this->sslConnection);
+    this->sslConnection = nullptr;
     this->sslActive = false;
     return;
 }
@@ -0,0 +1,161 @@
+//
+// server_handshake.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <thread>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/server_handshake.hpp"
+
+namespace server = frederick2::httpServer;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::handshakePool member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::handshakePool::handshakePool(size_t threadCount, size_t queueLimit)
+{
+    this->stopping = false;
+    this->maxQueue = queueLimit;
+    this->queuePeak = 0;
+    this->rejected = 0;
+    for(size_t index = 0; index < threadCount; index++)
+    {
+        this->workers.push_back(std::thread(&server::handshakePool::workerLoop, this));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::handshakePool::getQueueDepth
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::handshakePool::getQueueDepth()
+{
+    std::lock_guard<std::mutex> lockPool(this->poolLock);
+    return(this->pending.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::handshakePool::runStep
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::handshakePool::runStep
+(SSL *sslConnection, int& result, int& sslError, std::chrono::steady_clock::time_point deadline)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // one SSL_do_handshake call runs on a pool thread.  socket waits between
+    // steps stay on the calling connection thread so pool threads only ever
+    // spend time on handshake crypto.  SSL_get_error reads the per-thread
+    // error queue so it is evaluated on the worker as well
+    ///////////////////////////////////////////////////////////////////////////////
+
+    stepTask newTask{sslConnection, -1, SSL_ERROR_SSL, false};
+    std::unique_lock<std::mutex> lockPool(this->poolLock);
+    if(this->stopping || this->pending.size() >= this->maxQueue)
+    {
+        this->rejected++;
+        return(false);
+    }
+
+    this->pending.push_back(&newTask);
+    if(this->pending.size() > this->queuePeak)
+    {
+        this->queuePeak = this->pending.size();
+    }
+    this->taskReady.notify_one();
+
+    if(!this->taskDone.wait_until(lockPool, deadline, [&newTask]{return(newTask.done);}))
+    {
+        ///////////////////////////////////////////////////////////////////////////////
+        // still queued at the deadline: withdraw it.  a step already running
+        // is allowed to finish since the worker holds the SSL object
+        ///////////////////////////////////////////////////////////////////////////////
+
+        auto taskIter{std::find(this->pending.begin(), this->pending.end(), &newTask)};
+        if(taskIter != this->pending.end())
+        {
+            this->pending.erase(taskIter);
+            this->rejected++;
+            return(false);
+        }
+        this->taskDone.wait(lockPool, [&newTask]{return(newTask.done);});
+    }
+
+    result = newTask.result;
+    sslError = newTask.sslError;
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::handshakePool::workerLoop
+///////////////////////////////////////////////////////////////////////////////
+
+void server::handshakePool::workerLoop()
+{
+    std::unique_lock<std::mutex> lockPool(this->poolLock);
+    while(true)
+    {
+        this->taskReady.wait(lockPool, [this]{return(this->stopping || this->pending.size() > 0);});
+        if(this->pending.size() == 0)
+        {
+            return;
+        }
+
+        stepTask *curTask{this->pending.front()};
+        this->pending.pop_front();
+        lockPool.unlock();
+
+        ERR_clear_error();
+        int stepResult{SSL_do_handshake(curTask->sslConnection)};
+        int stepError{stepResult == 1 ? SSL_ERROR_NONE : SSL_get_error(curTask->sslConnection, stepResult)};
+
+        lockPool.lock();
+        curTask->result = stepResult;
+        curTask->sslError = stepError;
+        curTask->done = true;
+        this->taskDone.notify_all();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::handshakePool::~handshakePool()
+{
+    {
+        std::lock_guard<std::mutex> lockPool(this->poolLock);
+        this->stopping = true;
+    }
+    this->taskReady.notify_all();
+    for(std::thread& worker : this->workers)
+    {
+        if(worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
@@ -0,0 +1,1329 @@
+//
+// server_http2.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <memory>
+#include <openssl/ssl.h>
+#include <poll.h>
+#include <string>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/http_request.hpp"
+#include "../headers/http_response.hpp"
+#include "../headers/server.hpp"
+#include "../headers/server_connection.hpp"
+#include "../headers/server_enum.hpp"
+#include "../headers/server_http2.hpp"
+#include "../headers/server_memory.hpp"
+#include "../headers/server_metrics.hpp"
+#include "../headers/server_stream_pool.hpp"
+#include "../headers/utility_clock.hpp"
+#include "../headers/utility_parse.hpp"
+
+namespace enums = frederick2::httpEnums;
+namespace packet = frederick2::httpPacket;
+namespace server = frederick2::httpServer;
+namespace utility = frederick2::utility;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const std::string clientPreface{"PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"};
+static const unsigned char alpnProtocols[]{2, 'h', '2', 8, 'h', 't', 't', 'p', '/', '1', '.', '1'};
+
+///////////////////////////////////////////////////////////////////////////////
+// frame flags (RFC7540 [6])
+///////////////////////////////////////////////////////////////////////////////
+
+static const uint8_t flagAck{0x1};
+static const uint8_t flagEndStream{0x1};
+static const uint8_t flagEndHeaders{0x4};
+static const uint8_t flagPadded{0x8};
+static const uint8_t flagPriority{0x20};
+
+///////////////////////////////////////////////////////////////////////////////
+// local settings advertised in the server preface
+///////////////////////////////////////////////////////////////////////////////
+
+static const uint32_t localMaxFrame{16384};
+static const uint32_t localMaxStreams{128};
+static const uint32_t localInitialWindow{1048576};
+static const int64_t maxWindow{2147483647};
+static const size_t writeBudget{262144};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t readUint32(const char *data)
+{
+    const unsigned char *bytes{reinterpret_cast<const unsigned char*>(data)};
+    return((static_cast<uint32_t>(bytes[0]) << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3]);
+}
+
+static void appendUint32(std::string& target, uint32_t value)
+{
+    target.push_back(static_cast<char>((value >> 24) & 0xff));
+    target.push_back(static_cast<char>((value >> 16) & 0xff));
+    target.push_back(static_cast<char>((value >> 8) & 0xff));
+    target.push_back(static_cast<char>(value & 0xff));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::http2Session::http2Session(server::connection *parentConn, server::httpServer *hostServer)
+{
+    this->goawayReceived = false;
+    this->goawaySent = false;
+    this->continuationStream = 0;
+    this->lastStreamID = 0;
+    this->peerInitialWindow = 65535;
+    this->peerMaxFrame = 16384;
+    this->connSendWindow = 65535;
+    this->connRecvWindow = localInitialWindow;
+    this->virtualClock = 0;
+    this->lastActivity = std::chrono::steady_clock::now();
+    this->conn = parentConn;
+    this->host = hostServer;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::buildRequestText
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::http2Session::buildRequestText(streamState *stream, std::string& requestText)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // streams are handed to the existing request parser as an HTTP/1.1
+    // message.  pseudo-headers become the request line and Host, names are
+    // restored to canonical case since request header lookups are exact
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string method;
+    std::string path;
+    std::string authority;
+    bool regularSeen{false};
+    strMAPstr fieldValues;
+
+    for(const std::pair<std::string, std::string>& field : stream->requestFields)
+    {
+        if(field.first.size() > 0 && field.first[0] == ':')
+        {
+            if(regularSeen)
+            {
+                return(false);
+            }
+            if(field.first == ":method")
+            {
+                method = field.second;
+            }
+            else if(field.first == ":path")
+            {
+                path = field.second;
+            }
+            else if(field.first == ":authority")
+            {
+                authority = field.second;
+            }
+            else if(field.first != ":scheme")
+            {
+                return(false);
+            }
+            continue;
+        }
+
+        regularSeen = true;
+        if(field.first == "connection" || field.first == "keep-alive" || field.first == "proxy-connection" ||
+            field.first == "transfer-encoding" || field.first == "upgrade" || field.first == "te" || field.first == "content-length")
+        {
+            continue;
+        }
+
+        std::string canonicalName{field.first};
+        bool upperNext{true};
+        for(char& curChar : canonicalName)
+        {
+            if(upperNext && curChar >= 'a' && curChar <= 'z')
+            {
+                curChar -= 0x20;
+            }
+            upperNext = curChar == '-';
+        }
+
+        auto search{fieldValues.find(canonicalName)};
+        if(search == fieldValues.end())
+        {
+            fieldValues[canonicalName] = field.second;
+        }
+        else
+        {
+            search->second.append(canonicalName == "Cookie" ? "; " : ", ");
+            search->second.append(field.second);
+        }
+    }
+
+    if(method.size() == 0 || path.size() == 0)
+    {
+        return(false);
+    }
+    if(authority.size() > 0)
+    {
+        fieldValues["Host"] = authority;
+    }
+    if(stream->requestBody.size() > 0)
+    {
+        fieldValues["Content-Length"] = std::to_string(stream->requestBody.size());
+    }
+
+    requestText.reserve(path.size() + stream->requestBody.size() + 256);
+    requestText.append(method);
+    requestText.append(" ");
+    requestText.append(path);
+    requestText.append(" HTTP/1.1\r\n");
+    for(const std::pair<const std::string, std::string>& element : fieldValues)
+    {
+        requestText.append(element.first);
+        requestText.append(": ");
+        requestText.append(element.second);
+        requestText.append("\r\n");
+    }
+    requestText.append("\r\n");
+    requestText.append(stream->requestBody);
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::collectResponses
+///////////////////////////////////////////////////////////////////////////////
+
+void server::http2Session::collectResponses()
+{
+    auto streamIter{this->streams.begin()};
+    while(streamIter != this->streams.end())
+    {
+        streamState *stream{streamIter->second.get()};
+        if(!stream->dispatched || stream->queued || stream->headersSent)
+        {
+            streamIter++;
+            continue;
+        }
+        if(stream->response.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready)
+        {
+            streamIter++;
+            continue;
+        }
+
+        std::string rawResponse;
+        try
+        {
+            rawResponse = stream->response.get();
+        }
+        catch(const std::exception& e)
+        {
+            rawResponse.clear();
+        }
+        if(stream->cancelled)
+        {
+            streamIter = this->streams.erase(streamIter);
+            continue;
+        }
+
+        strPairVECTOR responseFields;
+        if(!server::http2Session::splitResponse(rawResponse, responseFields, stream->responseBody))
+        {
+            this->queueReset(stream->streamID, enums::h2ErrorCode::INTERNAL_ERROR);
+            streamIter = this->streams.erase(streamIter);
+            continue;
+        }
+
+        std::string headerBlock;
+        this->headerCodec.encode(responseFields, headerBlock);
+        bool endStream{stream->responseBody.size() == 0};
+        this->queueHeaders(stream->streamID, headerBlock, endStream);
+        if(endStream)
+        {
+            streamIter = this->streams.erase(streamIter);
+            continue;
+        }
+        stream->headersSent = true;
+        stream->virtualFinish = this->virtualClock;
+        streamIter++;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::dispatchStream
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::http2Session::dispatchStream(streamState *stream)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // each complete request runs as a task on the server's stream pool so
+    // slow handlers do not hold up the other streams multiplexed on this
+    // connection, without a thread per stream.  the task waits here, in
+    // stream order, while the pool's queue is full
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string requestText;
+    if(!server::http2Session::buildRequestText(stream, requestText))
+    {
+        this->queueReset(stream->streamID, enums::h2ErrorCode::PROTOCOL_ERROR);
+        this->streams.erase(stream->streamID);
+        return(false);
+    }
+
+    stream->requestBody.clear();
+    stream->requestFields.clear();
+    uint64_t openedTicks{stream->openedTicks};
+    stream->task = std::packaged_task<std::string()>([this, requestText{std::move(requestText)}, openedTicks]() mutable {
+        return(this->handleStream(std::move(requestText), openedTicks));
+    });
+    stream->response = stream->task.get_future();
+    stream->dispatched = true;
+    stream->queued = true;
+    this->submitQueued();
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::finishHeaders
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::http2Session::finishHeaders(streamState *stream)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // blocks are always decoded, even for refused streams or trailers,
+    // so the shared HPACK table stays in step with the client
+    ///////////////////////////////////////////////////////////////////////////////
+
+    strPairVECTOR decodedFields;
+    if(!this->headerCodec.decode(stream->headerBlock, decodedFields))
+    {
+        this->queueGoaway(enums::h2ErrorCode::COMPRESSION_ERROR);
+        return(false);
+    }
+    stream->headerBlock.clear();
+
+    if(stream->refused)
+    {
+        this->queueReset(stream->streamID, enums::h2ErrorCode::REFUSED_STREAM);
+        this->streams.erase(stream->streamID);
+        return(true);
+    }
+
+    if(stream->headersDone)
+    {
+        if(!stream->endStreamPending)
+        {
+            this->queueReset(stream->streamID, enums::h2ErrorCode::PROTOCOL_ERROR);
+            this->streams.erase(stream->streamID);
+            return(true);
+        }
+    }
+    else
+    {
+        ///////////////////////////////////////////////////////////////////////////////
+        // over the hard memory mark a stream with a body to follow is refused
+        // before any of it is buffered; REFUSED_STREAM is safe to retry
+        ///////////////////////////////////////////////////////////////////////////////
+
+        if(!stream->endStreamPending && this->host->memory->overHardLimit())
+        {
+            this->queueReset(stream->streamID, enums::h2ErrorCode::REFUSED_STREAM);
+            this->streams.erase(stream->streamID);
+            return(true);
+        }
+        stream->requestFields = std::move(decodedFields);
+        stream->headersDone = true;
+    }
+
+    if(stream->endStreamPending)
+    {
+        stream->remoteClosed = true;
+        this->dispatchStream(stream);
+    }
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::flush
+///////////////////////////////////////////////////////////////////////////////
+
+void server::http2Session::flush()
+{
+    if(this->outBuffer.size() == 0)
+    {
+        return;
+    }
+    if(this->conn->sslActive)
+    {
+        this->conn->sendDataSSL(std::move(this->outBuffer));
+    }
+    else
+    {
+        this->conn->sendData(std::move(this->outBuffer));
+    }
+    this->outBuffer.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::handleStream
+///////////////////////////////////////////////////////////////////////////////
+
+std::string server::http2Session::handleStream(std::string requestText, uint64_t openedTicks)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // stages run from the stream's HEADERS frame to the serialized
+    // response; frames are written later by the session loop
+    ///////////////////////////////////////////////////////////////////////////////
+
+    packet::httpRequest *request{this->host->acquireRequest(&requestText)};
+    request->stages.firstByte = openedTicks;
+    request->buildRequest();
+    packet::httpResponse *response{this->host->handleRequest(request, false)};
+    std::string returnString{response->toString()};
+    this->host->metrics->add(this->host->metricIDs.bytesOut, static_cast<int64_t>(returnString.size()));
+    uint64_t lastByte{utility::cycleClock::now()};
+    this->host->recordStages(request, lastByte);
+    this->host->logAccess(request, &this->conn->address, returnString.size(), lastByte);
+    this->host->releaseResponse(response);
+    this->host->releaseRequest(request);
+    return(returnString);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::processFrame
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::http2Session::processFrame
+(enums::h2FrameType frameType, uint8_t frameFlags, uint32_t streamID, const char *payload, size_t length)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // false means a connection error, GOAWAY has already been queued
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->continuationStream != 0 && (frameType != enums::h2FrameType::CONTINUATION || streamID != this->continuationStream))
+    {
+        this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+        return(false);
+    }
+
+    auto streamSearch{this->streams.find(streamID)};
+    streamState *stream{streamSearch == this->streams.end() ? nullptr : streamSearch->second.get()};
+
+    switch(frameType)
+    {
+        case enums::h2FrameType::DATA:
+        {
+            if(streamID == 0)
+            {
+                this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                return(false);
+            }
+            size_t padLength{0};
+            size_t dataStart{0};
+            if(frameFlags & flagPadded)
+            {
+                if(length < 1 || static_cast<unsigned char>(payload[0]) >= length)
+                {
+                    this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                    return(false);
+                }
+                padLength = static_cast<unsigned char>(payload[0]);
+                dataStart = 1;
+            }
+
+            ///////////////////////////////////////////////////////////////////////////////
+            // the whole frame, padding included, counts against both receive
+            // windows.  credit goes back later, from replenishWindows
+            ///////////////////////////////////////////////////////////////////////////////
+
+            if(static_cast<int64_t>(length) > this->connRecvWindow)
+            {
+                this->queueGoaway(enums::h2ErrorCode::FLOW_CONTROL_ERROR);
+                return(false);
+            }
+            this->connRecvWindow -= length;
+            if(stream == nullptr || stream->remoteClosed || !stream->headersDone)
+            {
+                if(streamID > this->lastStreamID)
+                {
+                    this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                    return(false);
+                }
+                this->queueReset(streamID, enums::h2ErrorCode::STREAM_CLOSED);
+                return(true);
+            }
+            if(static_cast<int64_t>(length) > stream->recvWindow)
+            {
+                this->queueReset(streamID, enums::h2ErrorCode::FLOW_CONTROL_ERROR);
+                this->streams.erase(streamID);
+                return(true);
+            }
+            stream->recvWindow -= length;
+            stream->recvPending += length;
+            stream->requestBody.append(payload + dataStart, length - dataStart - padLength);
+            if(frameFlags & flagEndStream)
+            {
+                stream->remoteClosed = true;
+                stream->recvPending = 0;
+                this->dispatchStream(stream);
+            }
+            return(true);
+        }
+        case enums::h2FrameType::HEADERS:
+        {
+            if(streamID == 0 || (streamID & 1) == 0)
+            {
+                this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                return(false);
+            }
+            size_t fragmentStart{0};
+            size_t padLength{0};
+            int streamWeight{16};
+            if(frameFlags & flagPadded)
+            {
+                if(length < 1)
+                {
+                    this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                    return(false);
+                }
+                padLength = static_cast<unsigned char>(payload[0]);
+                fragmentStart = 1;
+            }
+            if(frameFlags & flagPriority)
+            {
+                if(length < fragmentStart + 5)
+                {
+                    this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                    return(false);
+                }
+                streamWeight = static_cast<unsigned char>(payload[fragmentStart + 4]) + 1;
+                fragmentStart += 5;
+            }
+            if(fragmentStart + padLength > length)
+            {
+                this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                return(false);
+            }
+
+            if(stream == nullptr)
+            {
+                if(streamID <= this->lastStreamID)
+                {
+                    this->queueGoaway(enums::h2ErrorCode::STREAM_CLOSED);
+                    return(false);
+                }
+                this->lastStreamID = streamID;
+                std::unique_ptr<streamState> newStream{new streamState()};
+                newStream->streamID = streamID;
+                newStream->weight = streamWeight;
+                newStream->headersDone = false;
+                newStream->endStreamPending = false;
+                newStream->remoteClosed = false;
+                newStream->refused = this->goawaySent || this->streams.size() >= localMaxStreams;
+                newStream->dispatched = false;
+                newStream->queued = false;
+                newStream->headersSent = false;
+                newStream->cancelled = false;
+                newStream->sendWindow = this->peerInitialWindow;
+                newStream->recvWindow = localInitialWindow;
+                newStream->recvPending = 0;
+                newStream->virtualFinish = 0;
+                newStream->openedTicks = utility::cycleClock::now();
+                newStream->bodyOffset = 0;
+                stream = newStream.get();
+                this->streams[streamID] = std::move(newStream);
+            }
+            else if(stream->remoteClosed)
+            {
+                this->queueGoaway(enums::h2ErrorCode::STREAM_CLOSED);
+                return(false);
+            }
+            else if(frameFlags & flagPriority)
+            {
+                stream->weight = streamWeight;
+            }
+
+            stream->endStreamPending = (frameFlags & flagEndStream) != 0;
+            stream->headerBlock.append(payload + fragmentStart, length - fragmentStart - padLength);
+            if(frameFlags & flagEndHeaders)
+            {
+                return(this->finishHeaders(stream));
+            }
+            this->continuationStream = streamID;
+            return(true);
+        }
+        case enums::h2FrameType::CONTINUATION:
+        {
+            if(stream == nullptr || streamID != this->continuationStream)
+            {
+                this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                return(false);
+            }
+            stream->headerBlock.append(payload, length);
+            if(stream->headerBlock.size() > 65536)
+            {
+                this->queueGoaway(enums::h2ErrorCode::ENHANCE_YOUR_CALM);
+                return(false);
+            }
+            if(frameFlags & flagEndHeaders)
+            {
+                this->continuationStream = 0;
+                return(this->finishHeaders(stream));
+            }
+            return(true);
+        }
+        case enums::h2FrameType::PRIORITY:
+        {
+            if(streamID == 0)
+            {
+                this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                return(false);
+            }
+            if(length != 5)
+            {
+                this->queueReset(streamID, enums::h2ErrorCode::FRAME_SIZE_ERROR);
+                return(true);
+            }
+            if(stream != nullptr)
+            {
+                stream->weight = static_cast<unsigned char>(payload[4]) + 1;
+            }
+            return(true);
+        }
+        case enums::h2FrameType::RST_STREAM:
+        {
+            if(streamID == 0)
+            {
+                this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                return(false);
+            }
+            if(length != 4)
+            {
+                this->queueGoaway(enums::h2ErrorCode::FRAME_SIZE_ERROR);
+                return(false);
+            }
+            if(stream != nullptr)
+            {
+                ///////////////////////////////////////////////////////////////////////////////
+                // a running handler still owns its request, drop the stream once it returns.
+                // a task still waiting for the pool is simply discarded
+                ///////////////////////////////////////////////////////////////////////////////
+
+                if(stream->dispatched && !stream->queued && !stream->headersSent)
+                {
+                    stream->cancelled = true;
+                }
+                else
+                {
+                    this->streams.erase(streamID);
+                }
+            }
+            return(true);
+        }
+        case enums::h2FrameType::SETTINGS:
+        {
+            if(streamID != 0)
+            {
+                this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                return(false);
+            }
+            return(this->processSettings(frameFlags, payload, length));
+        }
+        case enums::h2FrameType::PUSH_PROMISE:
+        {
+            this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+            return(false);
+        }
+        case enums::h2FrameType::PING:
+        {
+            if(streamID != 0)
+            {
+                this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                return(false);
+            }
+            if(length != 8)
+            {
+                this->queueGoaway(enums::h2ErrorCode::FRAME_SIZE_ERROR);
+                return(false);
+            }
+            if(!(frameFlags & flagAck))
+            {
+                this->queueFrame(enums::h2FrameType::PING, flagAck, 0, payload, length);
+            }
+            return(true);
+        }
+        case enums::h2FrameType::GOAWAY:
+        {
+            if(streamID != 0)
+            {
+                this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                return(false);
+            }
+            this->goawayReceived = true;
+            return(true);
+        }
+        case enums::h2FrameType::WINDOW_UPDATE:
+        {
+            if(length != 4)
+            {
+                this->queueGoaway(enums::h2ErrorCode::FRAME_SIZE_ERROR);
+                return(false);
+            }
+            uint32_t increment{readUint32(payload) & 0x7fffffff};
+            if(streamID == 0)
+            {
+                this->connSendWindow += increment;
+                if(increment == 0 || this->connSendWindow > maxWindow)
+                {
+                    this->queueGoaway(increment == 0 ? enums::h2ErrorCode::PROTOCOL_ERROR : enums::h2ErrorCode::FLOW_CONTROL_ERROR);
+                    return(false);
+                }
+                return(true);
+            }
+            if(stream != nullptr)
+            {
+                stream->sendWindow += increment;
+                if(increment == 0 || stream->sendWindow > maxWindow)
+                {
+                    this->queueReset(streamID, increment == 0 ? enums::h2ErrorCode::PROTOCOL_ERROR : enums::h2ErrorCode::FLOW_CONTROL_ERROR);
+                    stream->cancelled = true;
+                    if(!stream->dispatched || stream->queued || stream->headersSent)
+                    {
+                        this->streams.erase(streamID);
+                    }
+                }
+            }
+            return(true);
+        }
+        default:
+        {
+            ///////////////////////////////////////////////////////////////////////////////
+            // unknown frame types are ignored (RFC7540 [4.1])
+            ///////////////////////////////////////////////////////////////////////////////
+
+            return(true);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::processFrames
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::http2Session::processFrames()
+{
+    std::string& inBuffer{this->conn->receiveBuffer};
+    size_t offset{0};
+    bool returnValue{true};
+    while(inBuffer.size() - offset >= 9)
+    {
+        const unsigned char *frameHead{reinterpret_cast<const unsigned char*>(inBuffer.data() + offset)};
+        size_t length{(static_cast<size_t>(frameHead[0]) << 16) | (frameHead[1] << 8) | frameHead[2]};
+        enums::h2FrameType frameType{static_cast<enums::h2FrameType>(frameHead[3])};
+        uint8_t frameFlags{frameHead[4]};
+        uint32_t streamID{readUint32(inBuffer.data() + offset + 5) & 0x7fffffff};
+
+        if(length > localMaxFrame)
+        {
+            this->queueGoaway(enums::h2ErrorCode::FRAME_SIZE_ERROR);
+            returnValue = false;
+            break;
+        }
+        if(inBuffer.size() - offset < length + 9)
+        {
+            break;
+        }
+        if(!this->processFrame(frameType, frameFlags, streamID, inBuffer.data() + offset + 9, length))
+        {
+            returnValue = false;
+            break;
+        }
+        offset += length + 9;
+    }
+
+    inBuffer.erase(0, offset);
+    return(returnValue);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::processSettings
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::http2Session::processSettings(uint8_t frameFlags, const char *payload, size_t length)
+{
+    if(frameFlags & flagAck)
+    {
+        if(length != 0)
+        {
+            this->queueGoaway(enums::h2ErrorCode::FRAME_SIZE_ERROR);
+            return(false);
+        }
+        return(true);
+    }
+    if(length % 6 != 0)
+    {
+        this->queueGoaway(enums::h2ErrorCode::FRAME_SIZE_ERROR);
+        return(false);
+    }
+
+    for(size_t offset = 0; offset < length; offset += 6)
+    {
+        const unsigned char *entry{reinterpret_cast<const unsigned char*>(payload + offset)};
+        uint16_t settingID{static_cast<uint16_t>((entry[0] << 8) | entry[1])};
+        uint32_t settingValue{readUint32(payload + offset + 2)};
+        switch(settingID)
+        {
+            case 0x1:
+                this->headerCodec.setEncoderLimit(settingValue);
+                break;
+            case 0x2:
+                if(settingValue > 1)
+                {
+                    this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                    return(false);
+                }
+                break;
+            case 0x4:
+            {
+                if(settingValue > maxWindow)
+                {
+                    this->queueGoaway(enums::h2ErrorCode::FLOW_CONTROL_ERROR);
+                    return(false);
+                }
+                int64_t windowDelta{static_cast<int64_t>(settingValue) - this->peerInitialWindow};
+                for(std::pair<const uint32_t, std::unique_ptr<streamState>>& element : this->streams)
+                {
+                    element.second->sendWindow += windowDelta;
+                }
+                this->peerInitialWindow = settingValue;
+                break;
+            }
+            case 0x5:
+                if(settingValue < 16384 || settingValue > 16777215)
+                {
+                    this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+                    return(false);
+                }
+                this->peerMaxFrame = settingValue;
+                break;
+            default:
+                break;
+        }
+    }
+
+    this->queueFrame(enums::h2FrameType::SETTINGS, flagAck, 0, nullptr, 0);
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::queueFrame
+///////////////////////////////////////////////////////////////////////////////
+
+void server::http2Session::queueFrame
+(enums::h2FrameType frameType, uint8_t frameFlags, uint32_t streamID, const char *payload, size_t length)
+{
+    this->outBuffer.push_back(static_cast<char>((length >> 16) & 0xff));
+    this->outBuffer.push_back(static_cast<char>((length >> 8) & 0xff));
+    this->outBuffer.push_back(static_cast<char>(length & 0xff));
+    this->outBuffer.push_back(static_cast<char>(frameType));
+    this->outBuffer.push_back(static_cast<char>(frameFlags));
+    appendUint32(this->outBuffer, streamID & 0x7fffffff);
+    if(length > 0)
+    {
+        this->outBuffer.append(payload, length);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::queueGoaway
+///////////////////////////////////////////////////////////////////////////////
+
+void server::http2Session::queueGoaway(enums::h2ErrorCode errorCode)
+{
+    if(this->goawaySent)
+    {
+        return;
+    }
+    std::string payload;
+    appendUint32(payload, this->lastStreamID);
+    appendUint32(payload, static_cast<uint32_t>(errorCode));
+    this->queueFrame(enums::h2FrameType::GOAWAY, 0, 0, payload.data(), payload.size());
+    this->goawaySent = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::queueHeaders
+///////////////////////////////////////////////////////////////////////////////
+
+void server::http2Session::queueHeaders(uint32_t streamID, const std::string& headerBlock, bool endStream)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // blocks larger than the peer's frame size continue in CONTINUATION frames
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t offset{0};
+    bool firstFrame{true};
+    do
+    {
+        size_t fragmentSize{headerBlock.size() - offset};
+        if(fragmentSize > this->peerMaxFrame)
+        {
+            fragmentSize = this->peerMaxFrame;
+        }
+        bool lastFrame{offset + fragmentSize == headerBlock.size()};
+        uint8_t frameFlags{lastFrame ? flagEndHeaders : static_cast<uint8_t>(0)};
+        if(firstFrame && endStream)
+        {
+            frameFlags |= flagEndStream;
+        }
+        enums::h2FrameType frameType{firstFrame ? enums::h2FrameType::HEADERS : enums::h2FrameType::CONTINUATION};
+        this->queueFrame(frameType, frameFlags, streamID, headerBlock.data() + offset, fragmentSize);
+        offset += fragmentSize;
+        firstFrame = false;
+    } while(offset < headerBlock.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::queueReset
+///////////////////////////////////////////////////////////////////////////////
+
+void server::http2Session::queueReset(uint32_t streamID, enums::h2ErrorCode errorCode)
+{
+    std::string payload;
+    appendUint32(payload, static_cast<uint32_t>(errorCode));
+    this->queueFrame(enums::h2FrameType::RST_STREAM, 0, streamID, payload.data(), payload.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::queueWindowUpdate
+///////////////////////////////////////////////////////////////////////////////
+
+void server::http2Session::queueWindowUpdate(uint32_t streamID, uint32_t increment)
+{
+    std::string payload;
+    appendUint32(payload, increment & 0x7fffffff);
+    this->queueFrame(enums::h2FrameType::WINDOW_UPDATE, 0, streamID, payload.data(), payload.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::readPreface
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::http2Session::readPreface()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // h2c connections were already sniffed for the preface, TLS connections
+    // chose h2 through ALPN and must still open with it
+    ///////////////////////////////////////////////////////////////////////////////
+
+    auto deadline{std::chrono::steady_clock::now() + std::chrono::seconds(this->conn->maxTime)};
+    std::string& inBuffer{this->conn->receiveBuffer};
+    while(inBuffer.size() < clientPreface.size())
+    {
+        if(inBuffer.compare(0, inBuffer.size(), clientPreface, 0, inBuffer.size()) != 0)
+        {
+            return(false);
+        }
+        if(this->conn->connectionError || std::chrono::steady_clock::now() > deadline)
+        {
+            return(false);
+        }
+        if(this->conn->sslActive)
+        {
+            this->conn->readDataSSL();
+        }
+        else
+        {
+            this->conn->readData();
+        }
+        if(inBuffer.size() < clientPreface.size())
+        {
+            struct pollfd prefacePoll{this->conn->sock->getFD(), POLLIN, 0};
+            poll(&prefacePoll, 1, 10);
+        }
+    }
+
+    if(inBuffer.compare(0, clientPreface.size(), clientPreface) != 0)
+    {
+        return(false);
+    }
+    inBuffer.erase(0, clientPreface.size());
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::replenishWindows
+///////////////////////////////////////////////////////////////////////////////
+
+void server::http2Session::replenishWindows()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // credit is returned in half-window batches.  while the memory governor
+    // pauses this connection, bodies still buffered here keep their credit,
+    // so clients stall on flow control while other frames keep moving.
+    // bytes handed to a handler or discarded are always credited back
+    ///////////////////////////////////////////////////////////////////////////////
+
+    const int64_t creditBatch{localInitialWindow / 2};
+    bool holdCredit{this->host->memory->shouldPause(this->conn->memoryHeld)};
+    int64_t heldBytes{0};
+    for(std::pair<const uint32_t, std::unique_ptr<streamState>>& element : this->streams)
+    {
+        streamState *stream{element.second.get()};
+        if(stream->recvPending == 0)
+        {
+            continue;
+        }
+        if(holdCredit)
+        {
+            heldBytes += stream->recvPending;
+            continue;
+        }
+        if(stream->recvPending >= creditBatch)
+        {
+            this->queueWindowUpdate(stream->streamID, static_cast<uint32_t>(stream->recvPending));
+            stream->recvWindow += stream->recvPending;
+            stream->recvPending = 0;
+        }
+    }
+
+    int64_t connCredit{static_cast<int64_t>(localInitialWindow) - this->connRecvWindow - heldBytes};
+    if(connCredit >= creditBatch)
+    {
+        this->queueWindowUpdate(0, static_cast<uint32_t>(connCredit));
+        this->connRecvWindow += connCredit;
+    }
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::run
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::http2Session::run(std::future<void>& exitSignal)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // server preface: SETTINGS plus a connection WINDOW_UPDATE so uploads
+    // are not held to the 64KB default
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string settingsPayload;
+    const uint32_t localSettings[][2]{{0x3, localMaxStreams}, {0x4, localInitialWindow}, {0x5, localMaxFrame}};
+    for(const uint32_t *setting : localSettings)
+    {
+        settingsPayload.push_back(static_cast<char>((setting[0] >> 8) & 0xff));
+        settingsPayload.push_back(static_cast<char>(setting[0] & 0xff));
+        appendUint32(settingsPayload, setting[1]);
+    }
+    this->queueFrame(enums::h2FrameType::SETTINGS, 0, 0, settingsPayload.data(), settingsPayload.size());
+    this->queueWindowUpdate(0, localInitialWindow - 65535);
+    this->flush();
+
+    if(!this->readPreface())
+    {
+        this->queueGoaway(enums::h2ErrorCode::PROTOCOL_ERROR);
+        this->flush();
+        return(false);
+    }
+
+    int64_t maxIdleMills{static_cast<int64_t>(this->conn->maxTime) * 1000};
+    auto signalStatus{exitSignal.wait_for(std::chrono::milliseconds(0))};
+    while(signalStatus != std::future_status::ready && !this->conn->connectionError)
+    {
+        if(!this->processFrames())
+        {
+            break;
+        }
+        this->submitQueued();
+        this->replenishWindows();
+        this->collectResponses();
+        this->writeData();
+        this->flush();
+
+        size_t heldBytes{this->conn->receiveBuffer.size()};
+        for(const std::pair<const uint32_t, std::unique_ptr<streamState>>& streamEntry : this->streams)
+        {
+            heldBytes += streamEntry.second->headerBlock.size() + streamEntry.second->requestBody.size() + streamEntry.second->responseBody.size();
+        }
+        this->conn->holdMemory(heldBytes);
+
+        if(this->goawayReceived && this->streams.size() == 0)
+        {
+            break;
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////
+        // wait for input.  short waits while handlers are running so finished
+        // responses go out promptly, longer ones when the connection is idle
+        ///////////////////////////////////////////////////////////////////////////////
+
+        int waitMills{this->streams.size() > 0 ? 1 : 50};
+        bool readable{this->conn->sslActive && SSL_pending(this->conn->sslConnection) > 0};
+        if(!readable)
+        {
+            struct pollfd sessionPoll{this->conn->sock->getFD(), POLLIN, 0};
+            readable = poll(&sessionPoll, 1, waitMills) > 0;
+        }
+        if(readable)
+        {
+            this->lastActivity = std::chrono::steady_clock::now();
+            if(this->conn->sslActive)
+            {
+                this->conn->readDataSSL();
+            }
+            else
+            {
+                this->conn->readData();
+            }
+        }
+        else if(this->streams.size() == 0)
+        {
+            auto idleTime{std::chrono::steady_clock::now() - this->lastActivity};
+            if(std::chrono::duration_cast<std::chrono::milliseconds>(idleTime).count() > maxIdleMills)
+            {
+                this->host->metrics->increment(this->host->metricIDs.idleTimeouts);
+                break;
+            }
+        }
+
+        signalStatus = exitSignal.wait_for(std::chrono::milliseconds(0));
+    }
+
+    this->queueGoaway(enums::h2ErrorCode::NO_ERROR);
+    this->flush();
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::selectProtocol
+///////////////////////////////////////////////////////////////////////////////
+
+int server::http2Session::selectProtocol
+(SSL*, const unsigned char **selected, unsigned char *selectedLength, const unsigned char *offered, unsigned int offeredLength, void*)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // ALPN: prefer h2, then http/1.1.  clients offering neither proceed
+    // without ALPN and are served HTTP/1.1
+    ///////////////////////////////////////////////////////////////////////////////
+
+    unsigned char *chosen{nullptr};
+    int selectResult{SSL_select_next_proto(&chosen, selectedLength, alpnProtocols, sizeof(alpnProtocols), offered, offeredLength)};
+    if(selectResult != OPENSSL_NPN_NEGOTIATED)
+    {
+        return(SSL_TLSEXT_ERR_NOACK);
+    }
+    *selected = chosen;
+    return(SSL_TLSEXT_ERR_OK);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::splitResponse
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::http2Session::splitResponse(const std::string& rawResponse, strPairVECTOR& fields, std::string& body)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // the HTTP/1.1 serialization (fresh or from the response cache) is split
+    // back into :status, lower case fields and an unchunked body.
+    // connection specific fields have no meaning in HTTP/2 (RFC7540 [8.1.2.2])
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t headEnd{rawResponse.find("\r\n\r\n")};
+    size_t lineEnd{rawResponse.find("\r\n")};
+    if(headEnd == std::string::npos || lineEnd == std::string::npos || lineEnd < 12)
+    {
+        return(false);
+    }
+    fields.emplace_back(":status", rawResponse.substr(9, 3));
+
+    utility::parseUtilities parseUtil;
+    bool bodyChunked{false};
+    size_t lineStart{lineEnd + 2};
+    while(lineStart < headEnd)
+    {
+        lineEnd = rawResponse.find("\r\n", lineStart);
+        size_t colonFound{rawResponse.find(':', lineStart)};
+        if(colonFound == std::string::npos || colonFound > lineEnd)
+        {
+            return(false);
+        }
+        std::string fieldName;
+        parseUtil.toLower(rawResponse.substr(lineStart, colonFound - lineStart), fieldName);
+        size_t valueStart{rawResponse.find_first_not_of(" \t", colonFound + 1)};
+        std::string fieldValue;
+        if(valueStart != std::string::npos && valueStart < lineEnd)
+        {
+            fieldValue = rawResponse.substr(valueStart, lineEnd - valueStart);
+        }
+        lineStart = lineEnd + 2;
+
+        if(fieldName == "transfer-encoding")
+        {
+            bodyChunked = fieldValue.find("chunked") != std::string::npos;
+            continue;
+        }
+        if(fieldName == "connection" || fieldName == "keep-alive" || fieldName == "proxy-connection" || fieldName == "upgrade")
+        {
+            continue;
+        }
+        fields.emplace_back(std::move(fieldName), std::move(fieldValue));
+    }
+
+    size_t bodyStart{headEnd + 4};
+    if(!bodyChunked)
+    {
+        body.assign(rawResponse, bodyStart, std::string::npos);
+        return(true);
+    }
+
+    body.clear();
+    while(bodyStart < rawResponse.size())
+    {
+        size_t sizeEnd{rawResponse.find("\r\n", bodyStart)};
+        if(sizeEnd == std::string::npos)
+        {
+            return(false);
+        }
+        size_t chunkSize{0};
+        try
+        {
+            chunkSize = std::stoul(rawResponse.substr(bodyStart, sizeEnd - bodyStart), nullptr, 16);
+        }
+        catch(const std::exception& e)
+        {
+            return(false);
+        }
+        if(chunkSize == 0)
+        {
+            break;
+        }
+        body.append(rawResponse, sizeEnd + 2, chunkSize);
+        bodyStart = sizeEnd + 2 + chunkSize + 2;
+    }
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::submitQueued
+///////////////////////////////////////////////////////////////////////////////
+
+void server::http2Session::submitQueued()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // offers waiting tasks to the pool lowest stream first, stopping at the
+    // first refusal so later streams never overtake earlier ones
+    ///////////////////////////////////////////////////////////////////////////////
+
+    for(std::pair<const uint32_t, std::unique_ptr<streamState>>& element : this->streams)
+    {
+        streamState *stream{element.second.get()};
+        if(!stream->queued)
+        {
+            continue;
+        }
+        if(!this->host->streamWorkers->submit(stream->task))
+        {
+            return;
+        }
+        stream->queued = false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::http2Session::writeData
+///////////////////////////////////////////////////////////////////////////////
+
+void server::http2Session::writeData()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // weighted fair scheduling: each frame advances the stream's virtual
+    // finish time by size / weight and the stream furthest behind goes next,
+    // so bandwidth is shared in proportion to the client's priority weights
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t budget{writeBudget};
+    while(this->connSendWindow > 0 && budget > 0)
+    {
+        streamState *nextStream{nullptr};
+        for(std::pair<const uint32_t, std::unique_ptr<streamState>>& element : this->streams)
+        {
+            streamState *stream{element.second.get()};
+            if(!stream->headersSent || stream->sendWindow <= 0 || stream->bodyOffset >= stream->responseBody.size())
+            {
+                continue;
+            }
+            if(nextStream == nullptr || stream->virtualFinish < nextStream->virtualFinish)
+            {
+                nextStream = stream;
+            }
+        }
+        if(nextStream == nullptr)
+        {
+            break;
+        }
+
+        size_t frameSize{nextStream->responseBody.size() - nextStream->bodyOffset};
+        frameSize = frameSize < this->peerMaxFrame ? frameSize : this->peerMaxFrame;
+        frameSize = frameSize < static_cast<size_t>(nextStream->sendWindow) ? frameSize : nextStream->sendWindow;
+        frameSize = frameSize < static_cast<size_t>(this->connSendWindow) ? frameSize : this->connSendWindow;
+        frameSize = frameSize < budget ? frameSize : budget;
+
+        bool lastFrame{nextStream->bodyOffset + frameSize == nextStream->responseBody.size()};
+        this->queueFrame(enums::h2FrameType::DATA, lastFrame ? flagEndStream : 0, nextStream->streamID,
+            nextStream->responseBody.data() + nextStream->bodyOffset, frameSize);
+
+        nextStream->bodyOffset += frameSize;
+        nextStream->sendWindow -= frameSize;
+        this->connSendWindow -= frameSize;
+        budget -= frameSize;
+        this->virtualClock = nextStream->virtualFinish;
+        nextStream->virtualFinish += (frameSize * 256) / nextStream->weight;
+
+        if(lastFrame)
+        {
+            this->streams.erase(nextStream->streamID);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::http2Session::~http2Session()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // handlers still running or queued on the pool reference this session.
+    // tasks that never reached the pool are dropped with their streams
+    ///////////////////////////////////////////////////////////////////////////////
+
+    for(std::pair<const uint32_t, std::unique_ptr<streamState>>& element : this->streams)
+    {
+        if(element.second->response.valid() && !element.second->queued)
+        {
+            element.second->response.wait();
+        }
+    }
+    this->streams.clear();
+    this->conn = nullptr;
+    this->host = nullptr;
+}
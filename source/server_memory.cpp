@@ -0,0 +1,145 @@
+//
+// server_memory.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/server_memory.hpp"
+
+namespace server = frederick2::httpServer;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::memoryGovernor member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::memoryGovernor::memoryGovernor()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // a zero limit is never crossed; usage is still tracked for the gauge
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->softLimit = 0;
+    this->hardLimit = 0;
+    this->retryAfter = 5;
+    this->holders = 0;
+    this->usage = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::memoryGovernor::adjust
+///////////////////////////////////////////////////////////////////////////////
+
+void server::memoryGovernor::adjust(size_t oldBytes, size_t newBytes)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // callers report the full footprint they held before and after, so a
+    // missed update is corrected by the next one instead of drifting
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(newBytes > oldBytes)
+    {
+        this->usage.fetch_add(newBytes - oldBytes, std::memory_order_relaxed);
+    }
+    else if(oldBytes > newBytes)
+    {
+        this->usage.fetch_sub(oldBytes - newBytes, std::memory_order_relaxed);
+    }
+
+    if(oldBytes == 0 && newBytes > 0)
+    {
+        this->holders.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if(oldBytes > 0 && newBytes == 0)
+    {
+        this->holders.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::memoryGovernor::getUsage
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::memoryGovernor::getUsage()
+{
+    return(this->usage.load(std::memory_order_relaxed));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::memoryGovernor::overHardLimit
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::memoryGovernor::overHardLimit()
+{
+    return(this->hardLimit > 0 && this->getUsage() > this->hardLimit);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::memoryGovernor::overSoftLimit
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::memoryGovernor::overSoftLimit()
+{
+    return(this->softLimit > 0 && this->getUsage() > this->softLimit);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::memoryGovernor::setLimits
+///////////////////////////////////////////////////////////////////////////////
+
+void server::memoryGovernor::setLimits(size_t soft, size_t hard)
+{
+    this->softLimit = soft;
+    this->hardLimit = hard;
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::memoryGovernor::shouldPause
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::memoryGovernor::shouldPause(size_t heldBytes)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // above the soft mark, connections holding more than the average share
+    // stop reading and let TCP push back on the client.  at least one holder
+    // is always at or under the average, so the lightest keep draining
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(heldBytes == 0 || !this->overSoftLimit())
+    {
+        return(false);
+    }
+    size_t holderCount{this->holders.load(std::memory_order_relaxed)};
+    if(holderCount < 2)
+    {
+        return(false);
+    }
+    return(heldBytes > this->getUsage() / holderCount);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::memoryGovernor::~memoryGovernor()
+{
+}
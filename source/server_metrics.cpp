@@ -0,0 +1,857 @@
+//
+// server_metrics.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/server_enum.hpp"
+#include "../headers/server_metrics.hpp"
+#include "../headers/utility_clock.hpp"
+
+namespace enums = frederick2::httpEnums;
+namespace server = frederick2::httpServer;
+namespace utility = frederick2::utility;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+thread_local server::metricsRegistry::shardLease server::metricsRegistry::localLease;
+
+// exposition bounds for latency histograms, in seconds; fixed so le labels never move between scrapes
+static constexpr double latencyExportBounds[]{0.000001, 0.000002, 0.000005, 0.00001, 0.00002, 0.00005, 0.0001, 0.0002, 0.0005, 0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1, 2, 5, 10};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::shard member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+server::metricsRegistry::shard::shard()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // pages are allocated by the leasing thread the first time it writes
+    // a slot in them, so a thread only pays for the series it touches
+    ///////////////////////////////////////////////////////////////////////////////
+
+    for(std::atomic<slotPage*>& curPage : this->pages)
+    {
+        curPage.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+server::metricsRegistry::shard::~shard()
+{
+    for(std::atomic<slotPage*>& curPage : this->pages)
+    {
+        delete curPage.load(std::memory_order_relaxed);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::shardLease member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void server::metricsRegistry::shardLease::release()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // the shard keeps its totals; the next thread to lease it carries on
+    // counting from there, so a scrape never loses a finished thread's work
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->pool != nullptr && this->local != nullptr)
+    {
+        std::lock_guard<std::mutex> poolGuard{this->pool->poolLock};
+        this->pool->freeShards.push_back(this->local);
+    }
+    this->local = nullptr;
+    this->pool.reset();
+    this->seriesCache.clear();
+}
+
+server::metricsRegistry::shardLease::~shardLease()
+{
+    this->release();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::metricsRegistry::metricsRegistry()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // slot 0 is never handed out as a series.  lookups that fail land there
+    // and anything written to it is never rendered
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->slotsUsed = 1;
+    this->slotFamily.fill(nullptr);
+    this->pool = std::make_shared<shardPool>();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::add
+///////////////////////////////////////////////////////////////////////////////
+
+void server::metricsRegistry::add(size_t seriesSlot, int64_t delta)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // gauges are kept as per thread deltas; a shard may go negative on its
+    // own and only the sum across shards is meaningful
+    ///////////////////////////////////////////////////////////////////////////////
+
+    server::metricsRegistry::bump(server::metricsRegistry::shardSlot(this->localShard(), seriesSlot), static_cast<uint64_t>(delta));
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::addCounter
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::metricsRegistry::addCounter(const std::string& metricName, const std::string& metricHelp, const strVECTOR& labelNames)
+{
+    return(this->addFamily(metricName, metricHelp, enums::metricType::COUNTER, std::vector<double>{}, labelNames));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::addFamily
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::metricsRegistry::addFamily(const std::string& metricName, const std::string& metricHelp, enums::metricType metricKind, const std::vector<double>& bucketBounds, const strVECTOR& labelNames)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // families live in a deque so series already handed out keep pointing
+    // at theirs while new ones are added.  registering a name twice returns
+    // the family already there
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::lock_guard<std::mutex> registryGuard{this->registryLock};
+    for(size_t index = 0; index < this->families.size(); index++)
+    {
+        if(this->families[index].name == metricName)
+        {
+            return(index);
+        }
+    }
+
+    metricFamily& newFamily{this->families.emplace_back()};
+    newFamily.name = metricName;
+    newFamily.help = metricHelp;
+    newFamily.type = metricKind;
+    newFamily.logLinear = false;
+    newFamily.labelNames = labelNames;
+    newFamily.bounds = bucketBounds;
+    std::sort(newFamily.bounds.begin(), newFamily.bounds.end());
+    return(this->families.size() - 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::addGauge
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::metricsRegistry::addGauge(const std::string& metricName, const std::string& metricHelp, const strVECTOR& labelNames)
+{
+    return(this->addFamily(metricName, metricHelp, enums::metricType::GAUGE, std::vector<double>{}, labelNames));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::addGaugeFunction
+///////////////////////////////////////////////////////////////////////////////
+
+void server::metricsRegistry::addGaugeFunction(const std::string& metricName, const std::string& metricHelp, std::function<double()> gaugeSampler)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // for values something else already tracks; sampled at scrape time
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t familyIndex{this->addFamily(metricName, metricHelp, enums::metricType::GAUGE, std::vector<double>{}, strVECTOR{})};
+    std::lock_guard<std::mutex> registryGuard{this->registryLock};
+    this->families[familyIndex].sampler = std::move(gaugeSampler);
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::addHistogram
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::metricsRegistry::addHistogram(const std::string& metricName, const std::string& metricHelp, const std::vector<double>& bucketBounds, const strVECTOR& labelNames)
+{
+    return(this->addFamily(metricName, metricHelp, enums::metricType::HISTOGRAM, bucketBounds, labelNames));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::addLatencyHistogram
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::metricsRegistry::addLatencyHistogram(const std::string& metricName, const std::string& metricHelp, const strVECTOR& labelNames)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // HDR style log-linear buckets over raw cycleClock ticks: every power of
+    // two is split into latencySubCount linear steps, so any sample lands in
+    // a bucket within 1/latencySubCount of its value.  observeTicks picks the
+    // bucket from the leading zero count with no search or conversion
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t familyIndex{this->addFamily(metricName, metricHelp, enums::metricType::HISTOGRAM, std::vector<double>{}, labelNames)};
+    std::lock_guard<std::mutex> registryGuard{this->registryLock};
+    this->families[familyIndex].logLinear = true;
+    return(familyIndex);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::addPage
+///////////////////////////////////////////////////////////////////////////////
+
+server::metricsRegistry::slotPage* server::metricsRegistry::addPage(std::atomic<slotPage*>& pageRef)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // kept out of shardSlot so the common path stays small enough to inline.
+    // release pairs with the acquire in sumSlot/sumDouble
+    ///////////////////////////////////////////////////////////////////////////////
+
+    slotPage *newPage{new slotPage()};
+    for(std::atomic<uint64_t>& curSlot : newPage->slots)
+    {
+        curSlot.store(0, std::memory_order_relaxed);
+    }
+    pageRef.store(newPage, std::memory_order_release);
+    return(newPage);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::appendLabelValue
+///////////////////////////////////////////////////////////////////////////////
+
+void server::metricsRegistry::appendLabelValue(std::string& outString, std::string_view labelValue)
+{
+    for(char curChar : labelValue)
+    {
+        if(curChar == '\\' || curChar == '"')
+        {
+            outString.push_back('\\');
+            outString.push_back(curChar);
+        }
+        else if(curChar == '\n')
+        {
+            outString.append("\\n");
+        }
+        else
+        {
+            outString.push_back(curChar);
+        }
+    }
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::appendNumber
+///////////////////////////////////////////////////////////////////////////////
+
+void server::metricsRegistry::appendNumber(std::string& outString, double numValue)
+{
+    char numBuffer[32];
+    if(std::isfinite(numValue) && std::floor(numValue) == numValue && std::fabs(numValue) < 1e15)
+    {
+        std::to_chars_result convResult{std::to_chars(numBuffer, numBuffer + sizeof(numBuffer), static_cast<int64_t>(numValue))};
+        outString.append(numBuffer, convResult.ptr - numBuffer);
+        return;
+    }
+    int numLength{std::snprintf(numBuffer, sizeof(numBuffer), "%.9g", numValue)};
+    outString.append(numBuffer, static_cast<size_t>(numLength));
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::bump
+///////////////////////////////////////////////////////////////////////////////
+
+void server::metricsRegistry::bump(std::atomic<uint64_t>& shardSlot, uint64_t delta)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // only the leasing thread writes its shard, so a relaxed load and store
+    // is enough and avoids a locked read-modify-write on every update.
+    // scrapes read with relaxed loads and always see a whole value
+    ///////////////////////////////////////////////////////////////////////////////
+
+    shardSlot.store(shardSlot.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::getSeries
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::metricsRegistry::getSeries(size_t familyIndex, std::initializer_list<std::string_view> labelValues)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // resolves a label set to its slot.  each thread caches what it has
+    // looked up, so only the first use of a label set on a thread takes
+    // the registry lock.  label values are given in the order the names
+    // were registered; 0 comes back if they do not match or slots run out
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->localShard();
+    shardLease& lease{server::metricsRegistry::localLease};
+    std::string& seriesKey{lease.keyScratch};
+    seriesKey.clear();
+    char indexBuffer[24];
+    std::to_chars_result convResult{std::to_chars(indexBuffer, indexBuffer + sizeof(indexBuffer), familyIndex)};
+    seriesKey.append(indexBuffer, convResult.ptr - indexBuffer);
+    for(std::string_view labelValue : labelValues)
+    {
+        seriesKey.push_back('\x1f');
+        seriesKey.append(labelValue);
+    }
+
+    auto cacheFound{lease.seriesCache.find(std::string_view{seriesKey})};
+    if(cacheFound != lease.seriesCache.end())
+    {
+        return(cacheFound->second);
+    }
+
+    size_t seriesSlot{0};
+    {
+        std::lock_guard<std::mutex> registryGuard{this->registryLock};
+        auto indexFound{this->seriesIndex.find(seriesKey)};
+        if(indexFound != this->seriesIndex.end())
+        {
+            seriesSlot = indexFound->second;
+        }
+        else if(familyIndex < this->families.size())
+        {
+            metricFamily& curFamily{this->families[familyIndex]};
+            size_t slotWidth{1};
+            if(curFamily.logLinear)
+            {
+                slotWidth = server::metricsRegistry::latencyBuckets + 1;
+            }
+            else if(curFamily.type == enums::metricType::HISTOGRAM)
+            {
+                slotWidth = curFamily.bounds.size() + 3;
+            }
+            if(curFamily.sampler || labelValues.size() != curFamily.labelNames.size() || this->slotsUsed + slotWidth > server::metricsRegistry::slotCapacity)
+            {
+                return(0);
+            }
+
+            std::string seriesLabels;
+            size_t labelIndex{0};
+            for(std::string_view labelValue : labelValues)
+            {
+                if(labelIndex > 0)
+                {
+                    seriesLabels.push_back(',');
+                }
+                seriesLabels.append(curFamily.labelNames[labelIndex]);
+                seriesLabels.append("=\"");
+                server::metricsRegistry::appendLabelValue(seriesLabels, labelValue);
+                seriesLabels.push_back('"');
+                labelIndex++;
+            }
+
+            seriesSlot = this->slotsUsed;
+            this->slotsUsed += slotWidth;
+            this->slotFamily[seriesSlot] = &curFamily;
+            curFamily.seriesSlots.push_back(seriesSlot);
+            curFamily.seriesLabels.push_back(std::move(seriesLabels));
+            this->seriesIndex.emplace(seriesKey, seriesSlot);
+        }
+    }
+    lease.seriesCache.emplace(seriesKey, seriesSlot);
+    return(seriesSlot);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::increment
+///////////////////////////////////////////////////////////////////////////////
+
+void server::metricsRegistry::increment(size_t seriesSlot)
+{
+    server::metricsRegistry::bump(server::metricsRegistry::shardSlot(this->localShard(), seriesSlot), 1);
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::latencyBucket
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::metricsRegistry::latencyBucket(uint64_t tickCount)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // the first latencySubCount buckets are exact; after that the exponent
+    // picks the group and the next latencySubBits bits the step within it
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(tickCount < server::metricsRegistry::latencySubCount)
+    {
+        return(static_cast<size_t>(tickCount));
+    }
+    size_t tickExponent{static_cast<size_t>(63 - __builtin_clzll(tickCount))};
+    size_t subStep{static_cast<size_t>(tickCount >> (tickExponent - server::metricsRegistry::latencySubBits)) & (server::metricsRegistry::latencySubCount - 1)};
+    size_t bucketIndex{(tickExponent - server::metricsRegistry::latencySubBits + 1) * server::metricsRegistry::latencySubCount + subStep};
+    return(std::min(bucketIndex, server::metricsRegistry::latencyBuckets - 1));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::latencyBucketEnd
+///////////////////////////////////////////////////////////////////////////////
+
+uint64_t server::metricsRegistry::latencyBucketEnd(size_t bucketIndex)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // first tick past the bucket (exclusive upper edge)
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(bucketIndex < server::metricsRegistry::latencySubCount)
+    {
+        return(bucketIndex + 1);
+    }
+    size_t tickExponent{bucketIndex / server::metricsRegistry::latencySubCount + server::metricsRegistry::latencySubBits - 1};
+    uint64_t stepSize{uint64_t{1} << (tickExponent - server::metricsRegistry::latencySubBits)};
+    uint64_t subStep{bucketIndex % server::metricsRegistry::latencySubCount};
+    return((uint64_t{1} << tickExponent) + (subStep + 1) * stepSize);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::localShard
+///////////////////////////////////////////////////////////////////////////////
+
+server::metricsRegistry::shard* server::metricsRegistry::localShard()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // every thread writes only to the shard it leases, so updates are plain
+    // relaxed stores on a cache line no other writer touches.  a thread that
+    // moves to another registry hands its shard back first
+    ///////////////////////////////////////////////////////////////////////////////
+
+    shardLease& lease{server::metricsRegistry::localLease};
+    if(lease.pool == this->pool)
+    {
+        return(lease.local);
+    }
+
+    lease.release();
+    lease.pool = this->pool;
+    std::lock_guard<std::mutex> poolGuard{this->pool->poolLock};
+    if(this->pool->freeShards.empty())
+    {
+        std::unique_ptr<shard> newShard{new shard()};
+        lease.local = newShard.get();
+        this->pool->shards.push_back(std::move(newShard));
+    }
+    else
+    {
+        lease.local = this->pool->freeShards.back();
+        this->pool->freeShards.pop_back();
+    }
+    return(lease.local);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::observe
+///////////////////////////////////////////////////////////////////////////////
+
+void server::metricsRegistry::observe(size_t seriesSlot, double sampleValue)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // histogram slots: one per bucket plus +Inf, then sum and count.
+    // buckets are counted individually and made cumulative on render.  the
+    // sum is a double kept as raw bits; only the leasing thread writes it
+    ///////////////////////////////////////////////////////////////////////////////
+
+    const metricFamily *curFamily{seriesSlot == 0 ? nullptr : this->slotFamily[seriesSlot]};
+    if(curFamily == nullptr || curFamily->type != enums::metricType::HISTOGRAM || curFamily->logLinear)
+    {
+        return;
+    }
+
+    shard *local{this->localShard()};
+    size_t boundCount{curFamily->bounds.size()};
+    size_t bucketIndex{static_cast<size_t>(std::lower_bound(curFamily->bounds.begin(), curFamily->bounds.end(), sampleValue) - curFamily->bounds.begin())};
+    server::metricsRegistry::bump(server::metricsRegistry::shardSlot(local, seriesSlot + bucketIndex), 1);
+
+    std::atomic<uint64_t>& sumSlot{server::metricsRegistry::shardSlot(local, seriesSlot + boundCount + 1)};
+    uint64_t sumBits{sumSlot.load(std::memory_order_relaxed)};
+    double sumValue{0};
+    std::memcpy(&sumValue, &sumBits, sizeof(sumValue));
+    sumValue += sampleValue;
+    std::memcpy(&sumBits, &sumValue, sizeof(sumBits));
+    sumSlot.store(sumBits, std::memory_order_relaxed);
+
+    server::metricsRegistry::bump(server::metricsRegistry::shardSlot(local, seriesSlot + boundCount + 2), 1);
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::observeTicks
+///////////////////////////////////////////////////////////////////////////////
+
+void server::metricsRegistry::observeTicks(size_t seriesSlot, uint64_t tickCount)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // request path: two plain stores into this thread's shard.  the slot
+    // must come from a family made with addLatencyHistogram; the count is
+    // the sum of the buckets and is worked out on render
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(seriesSlot == 0)
+    {
+        return;
+    }
+    shard *local{this->localShard()};
+    server::metricsRegistry::bump(server::metricsRegistry::shardSlot(local, seriesSlot + server::metricsRegistry::latencyBucket(tickCount)), 1);
+    server::metricsRegistry::bump(server::metricsRegistry::shardSlot(local, seriesSlot + server::metricsRegistry::latencyBuckets), tickCount);
+    return;
+}
+
+void server::metricsRegistry::observeTicks(const size_t *seriesSlots, const uint64_t *tickCounts, size_t sampleCount)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // several samples for one request in a single pass, resolving this
+    // thread's shard once instead of per sample
+    ///////////////////////////////////////////////////////////////////////////////
+
+    shard *local{this->localShard()};
+    for(size_t index = 0; index < sampleCount; index++)
+    {
+        size_t seriesSlot{seriesSlots[index]};
+        if(seriesSlot == 0)
+        {
+            continue;
+        }
+        server::metricsRegistry::bump(server::metricsRegistry::shardSlot(local, seriesSlot + server::metricsRegistry::latencyBucket(tickCounts[index])), 1);
+        server::metricsRegistry::bump(server::metricsRegistry::shardSlot(local, seriesSlot + server::metricsRegistry::latencyBuckets), tickCounts[index]);
+    }
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::quantile
+///////////////////////////////////////////////////////////////////////////////
+
+double server::metricsRegistry::quantile(size_t seriesSlot, double quantileRank)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // seconds at the given rank (0.0 - 1.0) of a latency histogram, taken
+    // from the middle of the bucket it falls in; 0 when nothing is recorded
+    ///////////////////////////////////////////////////////////////////////////////
+
+    double tickSeconds{utility::cycleClock::secondsPerTick()};
+    std::lock_guard<std::mutex> registryGuard{this->registryLock};
+    std::lock_guard<std::mutex> poolGuard{this->pool->poolLock};
+    const metricFamily *curFamily{seriesSlot == 0 ? nullptr : this->slotFamily[seriesSlot]};
+    if(curFamily == nullptr || !curFamily->logLinear)
+    {
+        return(0);
+    }
+
+    std::vector<uint64_t> bucketCounts(server::metricsRegistry::latencyBuckets);
+    uint64_t sampleCount{0};
+    for(size_t bucketIndex = 0; bucketIndex < server::metricsRegistry::latencyBuckets; bucketIndex++)
+    {
+        bucketCounts[bucketIndex] = this->sumSlot(seriesSlot + bucketIndex);
+        sampleCount += bucketCounts[bucketIndex];
+    }
+    if(sampleCount == 0)
+    {
+        return(0);
+    }
+
+    quantileRank = std::min(std::max(quantileRank, 0.0), 1.0);
+    uint64_t targetRank{std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantileRank * static_cast<double>(sampleCount))))};
+    uint64_t runningCount{0};
+    for(size_t bucketIndex = 0; bucketIndex < server::metricsRegistry::latencyBuckets; bucketIndex++)
+    {
+        runningCount += bucketCounts[bucketIndex];
+        if(runningCount >= targetRank)
+        {
+            uint64_t bucketStart{bucketIndex == 0 ? 0 : server::metricsRegistry::latencyBucketEnd(bucketIndex - 1)};
+            uint64_t bucketEnd{server::metricsRegistry::latencyBucketEnd(bucketIndex)};
+            return((static_cast<double>(bucketStart) + static_cast<double>(bucketEnd)) / 2.0 * tickSeconds);
+        }
+    }
+    return(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::render
+///////////////////////////////////////////////////////////////////////////////
+
+std::string server::metricsRegistry::render()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // Prometheus text exposition format 0.0.4.  shards are summed here,
+    // on the scraping thread, never on the request path
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string outString;
+    double tickSeconds{utility::cycleClock::secondsPerTick()};
+    std::lock_guard<std::mutex> registryGuard{this->registryLock};
+    std::lock_guard<std::mutex> poolGuard{this->pool->poolLock};
+
+    for(const metricFamily& curFamily : this->families)
+    {
+        outString.append("# HELP ").append(curFamily.name).append(" ").append(curFamily.help).append("\n");
+        outString.append("# TYPE ").append(curFamily.name);
+        switch(curFamily.type)
+        {
+            case enums::metricType::COUNTER:
+                outString.append(" counter\n");
+                break;
+            case enums::metricType::GAUGE:
+                outString.append(" gauge\n");
+                break;
+            case enums::metricType::HISTOGRAM:
+                outString.append(" histogram\n");
+                break;
+        }
+
+        if(curFamily.sampler)
+        {
+            outString.append(curFamily.name).append(" ");
+            server::metricsRegistry::appendNumber(outString, curFamily.sampler());
+            outString.append("\n");
+            continue;
+        }
+
+        for(size_t seriesIndex = 0; seriesIndex < curFamily.seriesSlots.size(); seriesIndex++)
+        {
+            size_t seriesSlot{curFamily.seriesSlots[seriesIndex]};
+            const std::string& seriesLabels{curFamily.seriesLabels[seriesIndex]};
+            if(curFamily.type != enums::metricType::HISTOGRAM)
+            {
+                outString.append(curFamily.name);
+                if(seriesLabels.size() > 0)
+                {
+                    outString.append("{").append(seriesLabels).append("}");
+                }
+                outString.append(" ");
+                uint64_t slotTotal{this->sumSlot(seriesSlot)};
+                if(curFamily.type == enums::metricType::GAUGE)
+                {
+                    server::metricsRegistry::appendNumber(outString, static_cast<double>(static_cast<int64_t>(slotTotal)));
+                }
+                else
+                {
+                    server::metricsRegistry::appendNumber(outString, static_cast<double>(slotTotal));
+                }
+                outString.append("\n");
+                continue;
+            }
+
+            if(curFamily.logLinear)
+            {
+                ///////////////////////////////////////////////////////////////////////////////
+                // the fine buckets are kept for quantile().  the exposition
+                // folds them into fixed second bounds, each fine bucket going
+                // to the first bound at or past its upper edge, so a count is
+                // off by at most one fine bucket width.  series nothing was
+                // recorded against (routes never hit) are left out
+                ///////////////////////////////////////////////////////////////////////////////
+
+                std::array<uint64_t, std::size(latencyExportBounds) + 1> exportCounts{};
+                uint64_t runningCount{0};
+                size_t boundIndex{0};
+                for(size_t bucketIndex = 0; bucketIndex < server::metricsRegistry::latencyBuckets; bucketIndex++)
+                {
+                    uint64_t bucketCount{this->sumSlot(seriesSlot + bucketIndex)};
+                    if(bucketCount == 0)
+                    {
+                        continue;
+                    }
+                    double bucketEnd{static_cast<double>(server::metricsRegistry::latencyBucketEnd(bucketIndex)) * tickSeconds};
+                    while(boundIndex < std::size(latencyExportBounds) && latencyExportBounds[boundIndex] < bucketEnd)
+                    {
+                        boundIndex++;
+                    }
+                    exportCounts[boundIndex] += bucketCount;
+                    runningCount += bucketCount;
+                }
+                if(runningCount == 0)
+                {
+                    continue;
+                }
+
+                uint64_t exportRunning{0};
+                for(size_t exportIndex = 0; exportIndex < exportCounts.size(); exportIndex++)
+                {
+                    exportRunning += exportCounts[exportIndex];
+                    outString.append(curFamily.name).append("_bucket{");
+                    if(seriesLabels.size() > 0)
+                    {
+                        outString.append(seriesLabels).append(",");
+                    }
+                    outString.append("le=\"");
+                    if(exportIndex < std::size(latencyExportBounds))
+                    {
+                        server::metricsRegistry::appendNumber(outString, latencyExportBounds[exportIndex]);
+                    }
+                    else
+                    {
+                        outString.append("+Inf");
+                    }
+                    outString.append("\"} ");
+                    server::metricsRegistry::appendNumber(outString, static_cast<double>(exportRunning));
+                    outString.append("\n");
+                }
+
+                std::string labelBlock;
+                if(seriesLabels.size() > 0)
+                {
+                    labelBlock.append("{").append(seriesLabels).append("}");
+                }
+                outString.append(curFamily.name).append("_sum").append(labelBlock).append(" ");
+                server::metricsRegistry::appendNumber(outString, static_cast<double>(this->sumSlot(seriesSlot + server::metricsRegistry::latencyBuckets)) * tickSeconds);
+                outString.append("\n");
+                outString.append(curFamily.name).append("_count").append(labelBlock).append(" ");
+                server::metricsRegistry::appendNumber(outString, static_cast<double>(runningCount));
+                outString.append("\n");
+                continue;
+            }
+
+            size_t boundCount{curFamily.bounds.size()};
+            uint64_t runningCount{0};
+            for(size_t bucketIndex = 0; bucketIndex <= boundCount; bucketIndex++)
+            {
+                runningCount += this->sumSlot(seriesSlot + bucketIndex);
+                outString.append(curFamily.name).append("_bucket{");
+                if(seriesLabels.size() > 0)
+                {
+                    outString.append(seriesLabels).append(",");
+                }
+                outString.append("le=\"");
+                if(bucketIndex < boundCount)
+                {
+                    server::metricsRegistry::appendNumber(outString, curFamily.bounds[bucketIndex]);
+                }
+                else
+                {
+                    outString.append("+Inf");
+                }
+                outString.append("\"} ");
+                server::metricsRegistry::appendNumber(outString, static_cast<double>(runningCount));
+                outString.append("\n");
+            }
+
+            std::string labelBlock;
+            if(seriesLabels.size() > 0)
+            {
+                labelBlock.append("{").append(seriesLabels).append("}");
+            }
+            outString.append(curFamily.name).append("_sum").append(labelBlock).append(" ");
+            server::metricsRegistry::appendNumber(outString, this->sumDouble(seriesSlot + boundCount + 1));
+            outString.append("\n");
+            outString.append(curFamily.name).append("_count").append(labelBlock).append(" ");
+            server::metricsRegistry::appendNumber(outString, static_cast<double>(this->sumSlot(seriesSlot + boundCount + 2)));
+            outString.append("\n");
+        }
+    }
+    return(outString);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::shardSlot
+///////////////////////////////////////////////////////////////////////////////
+
+std::atomic<uint64_t>& server::metricsRegistry::shardSlot(shard *local, size_t seriesSlot)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // local must be the calling thread's own shard (localShard()); only
+    // its owner allocates a page, so the relaxed load sees its own store
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::atomic<slotPage*>& pageRef{local->pages[seriesSlot / server::metricsRegistry::pageSlots]};
+    slotPage *curPage{pageRef.load(std::memory_order_relaxed)};
+    if(curPage == nullptr)
+    {
+        curPage = server::metricsRegistry::addPage(pageRef);
+    }
+    return(curPage->slots[seriesSlot % server::metricsRegistry::pageSlots]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::sumDouble
+///////////////////////////////////////////////////////////////////////////////
+
+double server::metricsRegistry::sumDouble(size_t seriesSlot)
+{
+    double slotTotal{0};
+    for(const std::unique_ptr<shard>& curShard : this->pool->shards)
+    {
+        const slotPage *curPage{curShard->pages[seriesSlot / server::metricsRegistry::pageSlots].load(std::memory_order_acquire)};
+        if(curPage == nullptr)
+        {
+            continue;
+        }
+        uint64_t slotBits{curPage->slots[seriesSlot % server::metricsRegistry::pageSlots].load(std::memory_order_relaxed)};
+        double slotValue{0};
+        std::memcpy(&slotValue, &slotBits, sizeof(slotValue));
+        slotTotal += slotValue;
+    }
+    return(slotTotal);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::metricsRegistry::sumSlot
+///////////////////////////////////////////////////////////////////////////////
+
+uint64_t server::metricsRegistry::sumSlot(size_t seriesSlot)
+{
+    uint64_t slotTotal{0};
+    for(const std::unique_ptr<shard>& curShard : this->pool->shards)
+    {
+        const slotPage *curPage{curShard->pages[seriesSlot / server::metricsRegistry::pageSlots].load(std::memory_order_acquire)};
+        if(curPage != nullptr)
+        {
+            slotTotal += curPage->slots[seriesSlot % server::metricsRegistry::pageSlots].load(std::memory_order_relaxed);
+        }
+    }
+    return(slotTotal);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::metricsRegistry::~metricsRegistry()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // threads still leasing a shard hold the pool alive and return their
+    // shard to it on exit
+    ///////////////////////////////////////////////////////////////////////////////
+
+    shardLease& lease{server::metricsRegistry::localLease};
+    if(lease.pool == this->pool)
+    {
+        lease.release();
+    }
+}
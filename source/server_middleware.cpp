@@ -0,0 +1,88 @@
+//
+// server_middleware.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <vector>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/http_request.hpp"
+#include "../headers/http_response.hpp"
+#include "../headers/server.hpp"
+#include "../headers/server_middleware.hpp"
+
+namespace packet = frederick2::httpPacket;
+namespace server = frederick2::httpServer;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::middlewareChain member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::middlewareChain::middlewareChain
+(const std::vector<const httpMiddleware*> *pipeline, packet::httpRequest *request, packet::httpResponse *response, server::httpServer *hostServer, server::httpServer::dispatchState *dispatch)
+{
+    this->dispatched = false;
+    this->position = 0;
+    this->calls = pipeline;
+    this->inbound = request;
+    this->outbound = response;
+    this->host = hostServer;
+    this->state = dispatch;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::middlewareChain::next
+///////////////////////////////////////////////////////////////////////////////
+
+void server::middlewareChain::next()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // runs the next middleware, or the resource itself once every middleware
+    // has passed the request on.  code after next() in a middleware runs
+    // after the response is built.  returning without calling next()
+    // short-circuits with whatever response the middleware set
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->position < this->calls->size())
+    {
+        const httpMiddleware *curMiddleware{(*this->calls)[this->position++]};
+        (*curMiddleware)(this->inbound, this->outbound, *this);
+        return;
+    }
+    if(!this->dispatched)
+    {
+        this->dispatched = true;
+        this->host->dispatchResource(this->inbound, this->outbound, this->state);
+    }
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::middlewareChain::~middlewareChain()
+{
+    this->calls = nullptr;
+    this->inbound = nullptr;
+    this->outbound = nullptr;
+    this->host = nullptr;
+    this->state = nullptr;
+}
@@ -7,9 +7,15 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cctype>
 #include <functional>
 #include <map>
+#include <memory>
+#include <regex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "../headers/frederick2_namespace.hpp"
 #include "../headers/server_enum.hpp"
@@ -38,7 +44,10 @@ server::resource::resource(const std::string& targetName, enums::resourceType ta
 {
     this->hasDynamic = false;
     this->hasFilesystem = false;
+    this->cacheTTL = 0;
+    this->stageSeries.fill(0);
     this->name = targetName;
+    this->paramKind = enums::paramType::STRING;
     this->type = targetType;
 }
 
@@ -83,13 +92,81 @@ server::resource* server::resource::addChild(const std::string& targetName, enum
     return(newResource);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::resource::addCacheVary
+///////////////////////////////////////////////////////////////////////////////
+
+void server::resource::addCacheVary(const std::string& headerName)
+{
+    this->cacheVary.push_back(headerName);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::resource::addHandler
 ///////////////////////////////////////////////////////////////////////////////
 
 void server::resource::addHandler(enums::httpMethod targetMethod, httpHandler targetFunction)
 {
-    this->handlers[targetMethod] = targetFunction;
+    size_t methodIndex{static_cast<size_t>(targetMethod)};
+    if(methodIndex < server::resource::methodCount)
+    {
+        this->handlers[methodIndex] = std::move(targetFunction);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::resource::addMiddleware
+///////////////////////////////////////////////////////////////////////////////
+
+void server::resource::addMiddleware(httpMiddleware targetFunction)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // applies to this resource and everything below it, outermost first
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->middleware.push_back(std::move(targetFunction));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::resource::clone
+///////////////////////////////////////////////////////////////////////////////
+
+server::resource* server::resource::clone()
+{
+    server::resource *newResource{new server::resource(this->name, this->type)};
+    newResource->hasDynamic = this->hasDynamic;
+    newResource->hasFilesystem = this->hasFilesystem;
+    newResource->cacheTTL = this->cacheTTL;
+    newResource->allowList = this->allowList;
+    newResource->cacheVary = this->cacheVary;
+    newResource->handlers = this->handlers;
+    newResource->middleware = this->middleware;
+    newResource->paramKind = this->paramKind;
+    newResource->paramChoices = this->paramChoices;
+    newResource->paramPattern = this->paramPattern;
+    for(const std::pair<const std::string, server::resource*>& child : this->children)
+    {
+        newResource->children[child.first] = child.second->clone();
+    }
+    return(newResource);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::resource::findHandler
+///////////////////////////////////////////////////////////////////////////////
+
+const httpHandler* server::resource::findHandler(enums::httpMethod targetMethod) const
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // request path dispatch: direct index, no copy of the std::function
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t methodIndex{static_cast<size_t>(targetMethod)};
+    if(methodIndex >= server::resource::methodCount || !this->handlers[methodIndex])
+    {
+        return(nullptr);
+    }
+    return(&this->handlers[methodIndex]);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -100,17 +177,14 @@ server::resource* server::resource::getChild(const std::string& targetName)
 {
     server::resource *returnResource{nullptr};
     
-    try
+    auto childSearch{this->children.find(targetName)};
+    if(childSearch != this->children.end())
     {
-        returnResource = this->children.at(targetName);
-        
+        returnResource = childSearch->second;
     }
-    catch(const std::out_of_range& e)
+    else if(this->hasDynamic)
     {
-        if(this->hasDynamic)
-        {
-            returnResource = this->children.at("@@DYNAMIC");
-        }
+        returnResource = this->children.find("@@DYNAMIC")->second;
     }
 
     return(returnResource); 
@@ -123,14 +197,12 @@ server::resource* server::resource::getChild(const std::string& targetName)
 handlerCheck server::resource::getHandler(enums::httpMethod targetMethod)
 {
     handlerCheck returnCheck;
-    returnCheck.first = true;
-    try
-    {
-        returnCheck.second = this->handlers.at(targetMethod);
-    }
-    catch(const std::out_of_range& e)
+    returnCheck.first = false;
+    const httpHandler *targetHandler{this->findHandler(targetMethod)};
+    if(targetHandler != nullptr)
     {
-        returnCheck.first = false;
+        returnCheck.first = true;
+        returnCheck.second = *targetHandler;
     }
     return(std::move(returnCheck));
 }
@@ -142,13 +214,17 @@ handlerCheck server::resource::getHandler(enums::httpMethod targetMethod)
 std::string server::resource::getMethodList()
 {
     std::string returnString;
-    for (auto it = this->handlers.begin(); it != this->handlers.end(); it++)
+    for(size_t methodIndex = 0; methodIndex < server::resource::methodCount; methodIndex++)
     {
+        if(!this->handlers[methodIndex])
+        {
+            continue;
+        }
         if(returnString.size() > 0)
         {
             returnString.append(", ");
         }
-        returnString.append(enums::converter::method2str(it->first));
+        returnString.append(enums::converter::method2str(static_cast<enums::httpMethod>(methodIndex)));
     }
     return(returnString);
 }
@@ -206,6 +282,88 @@ void server::resource::removeChild(const std::string& targetName)
     return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::resource::setCacheTTL
+///////////////////////////////////////////////////////////////////////////////
+
+void server::resource::setCacheTTL(size_t ttl)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // ttl in seconds for cached GET/HEAD responses.  0 disables caching
+    ///////////////////////////////////////////////////////////////////////////////
+    
+    this->cacheTTL = ttl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::resource::setParameterChoices
+///////////////////////////////////////////////////////////////////////////////
+
+void server::resource::setParameterChoices(const strVECTOR& choices)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // segment must equal one of choices (case-insensitive).  the index of
+    // the match is what httpRequest::getPathChoice returns
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->type != enums::resourceType::DYNAMIC)
+    {
+        return;
+    }
+    this->paramChoices.clear();
+    for(std::string choice : choices)
+    {
+        std::transform(choice.begin(), choice.end(), choice.begin(), [](unsigned char c){ return(std::tolower(c)); });
+        this->paramChoices.push_back(std::move(choice));
+    }
+    this->paramPattern.reset();
+    this->paramKind = enums::paramType::ENUMSET;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::resource::setParameterPattern
+///////////////////////////////////////////////////////////////////////////////
+
+void server::resource::setParameterPattern(const std::string& pattern)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // ECMAScript pattern that must match the whole decoded, lower cased
+    // segment.  compiled once here; throws std::regex_error if malformed
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->type != enums::resourceType::DYNAMIC)
+    {
+        return;
+    }
+    this->paramPattern = std::make_shared<const std::regex>(pattern, std::regex::ECMAScript | std::regex::optimize);
+    this->paramChoices.clear();
+    this->paramKind = enums::paramType::REGEX;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::resource::setParameterType
+///////////////////////////////////////////////////////////////////////////////
+
+void server::resource::setParameterType(enums::paramType targetType)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // STRING, INT64, UUID and HEX.  ENUMSET and REGEX carry their
+    // definition and are set through setParameterChoices/setParameterPattern
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->type != enums::resourceType::DYNAMIC)
+    {
+        return;
+    }
+    if(targetType == enums::paramType::ENUMSET || targetType == enums::paramType::REGEX || targetType == enums::paramType::ENUMERROR)
+    {
+        return;
+    }
+    this->paramChoices.clear();
+    this->paramPattern.reset();
+    this->paramKind = targetType;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Deconstructor
 ///////////////////////////////////////////////////////////////////////////////
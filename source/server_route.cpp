@@ -0,0 +1,410 @@
+//
+// server_route.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/http_request.hpp"
+#include "../headers/server_enum.hpp"
+#include "../headers/server_resource.hpp"
+#include "../headers/server_route.hpp"
+#include "../headers/server_uri.hpp"
+#include "../headers/utility_parse.hpp"
+
+namespace enums = frederick2::httpEnums;
+namespace packet = frederick2::httpPacket;
+namespace server = frederick2::httpServer;
+namespace utility = frederick2::utility;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int compareFolded(std::string_view label, std::string_view rawSegment)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // compares as if rawSegment had been lower cased, matching the byte
+    // order std::map used when the edges were sorted
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t compareLength{label.size() < rawSegment.size() ? label.size() : rawSegment.size()};
+    for(size_t index = 0; index < compareLength; index++)
+    {
+        unsigned char labelChar{static_cast<unsigned char>(label[index])};
+        unsigned char rawChar{static_cast<unsigned char>(rawSegment[index])};
+        if(rawChar >= 'A' && rawChar <= 'Z')
+        {
+            rawChar += 0x20;
+        }
+        if(labelChar != rawChar)
+        {
+            return(labelChar < rawChar ? -1 : 1);
+        }
+    }
+    if(label.size() == rawSegment.size())
+    {
+        return(0);
+    }
+    return(label.size() < rawSegment.size() ? -1 : 1);
+}
+
+static int hexValue(char hexChar)
+{
+    if(hexChar >= '0' && hexChar <= '9')
+    {
+        return(hexChar - '0');
+    }
+    if(hexChar >= 'a' && hexChar <= 'f')
+    {
+        return(hexChar - 'a' + 10);
+    }
+    if(hexChar >= 'A' && hexChar <= 'F')
+    {
+        return(hexChar - 'A' + 10);
+    }
+    return(-1);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::routeTable member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::routeTable::routeTable(server::resource *rootResource)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // the table owns a private copy of the tree so a published table never
+    // changes, whatever happens to the draft tree afterwards.  the Allow
+    // list for 405 responses and the inherited middleware sequence are
+    // built once per node here, along with the route template
+    // ("/items/{id}") that request metrics are labelled with.
+    // flatten the copy breadth first.  each node's static edges
+    // are contiguous and already sorted (std::map order) so lookups are a
+    // binary search over one array with labels packed into one string.
+    // the dynamic child, if any, is kept apart as the fallback edge
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->snapshotRoot = rootResource->clone();
+    this->snapshotRoot->routePath = "/";
+    std::vector<server::resource*> pending;
+    pending.push_back(this->snapshotRoot);
+    this->nodes.push_back(routeNode{this->snapshotRoot, this->snapshotRoot->type, 0, 0, -1});
+
+    for(size_t nodeIndex = 0; nodeIndex < pending.size(); nodeIndex++)
+    {
+        server::resource *curResource{pending[nodeIndex]};
+        curResource->allowList = curResource->getMethodList();
+        for(const httpMiddleware& ownMiddleware : curResource->middleware)
+        {
+            curResource->pipeline.push_back(&ownMiddleware);
+        }
+        uint32_t firstEdge{static_cast<uint32_t>(this->edges.size())};
+        server::resource *dynamicChild{nullptr};
+
+        if(curResource->type != enums::resourceType::FILESYSTEM)
+        {
+            for(const std::pair<const std::string, server::resource*>& child : curResource->children)
+            {
+                if(child.second->type == enums::resourceType::DYNAMIC)
+                {
+                    dynamicChild = child.second;
+                    continue;
+                }
+                uint32_t childNode{static_cast<uint32_t>(pending.size())};
+                this->edges.push_back(routeEdge{static_cast<uint32_t>(this->labels.size()), static_cast<uint32_t>(child.first.size()), childNode});
+                this->labels.append(child.first);
+                child.second->pipeline = curResource->pipeline;
+                child.second->routePath = curResource->routePath;
+                if(curResource != this->snapshotRoot)
+                {
+                    child.second->routePath.push_back('/');
+                }
+                child.second->routePath.append(child.first);
+                pending.push_back(child.second);
+                this->nodes.push_back(routeNode{child.second, child.second->type, 0, 0, -1});
+            }
+        }
+
+        this->nodes[nodeIndex].firstEdge = firstEdge;
+        this->nodes[nodeIndex].edgeCount = static_cast<uint32_t>(this->edges.size()) - firstEdge;
+        if(dynamicChild != nullptr)
+        {
+            this->nodes[nodeIndex].dynamicNode = static_cast<int32_t>(pending.size());
+            dynamicChild->pipeline = curResource->pipeline;
+            dynamicChild->routePath = curResource->routePath;
+            if(curResource != this->snapshotRoot)
+            {
+                dynamicChild->routePath.push_back('/');
+            }
+            dynamicChild->routePath.append("{").append(dynamicChild->name).append("}");
+            pending.push_back(dynamicChild);
+            this->nodes.push_back(routeNode{dynamicChild, dynamicChild->type, 0, 0, -1});
+        }
+    }
+
+    this->edges.shrink_to_fit();
+    this->nodes.shrink_to_fit();
+    this->labels.shrink_to_fit();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::routeTable::findStatic
+///////////////////////////////////////////////////////////////////////////////
+
+int32_t server::routeTable::findStatic(const routeNode& parentNode, std::string_view segment, bool foldCase) const
+{
+    size_t lowIndex{parentNode.firstEdge};
+    size_t highIndex{static_cast<size_t>(parentNode.firstEdge) + parentNode.edgeCount};
+    while(lowIndex < highIndex)
+    {
+        size_t midIndex{lowIndex + (highIndex - lowIndex) / 2};
+        const routeEdge& midEdge{this->edges[midIndex]};
+        std::string_view label{this->labels.data() + midEdge.labelOffset, midEdge.labelLength};
+        int compareResult{foldCase ? compareFolded(label, segment) : label.compare(segment)};
+        if(compareResult == 0)
+        {
+            return(static_cast<int32_t>(midEdge.node));
+        }
+        if(compareResult < 0)
+        {
+            lowIndex = midIndex + 1;
+        }
+        else
+        {
+            highIndex = midIndex;
+        }
+    }
+    return(-1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::routeTable::match
+///////////////////////////////////////////////////////////////////////////////
+
+server::resource* server::routeTable::match(packet::httpRequest *inbound) const
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // walks the raw request path.  plain segments are compared in place
+    // with case folding; only segments holding '%' or '+' are decoded.
+    // static edges win over the dynamic fallback, which captures the raw
+    // segment as a view and, for a typed parameter, validates and converts
+    // it into the request's fixed pathValues slots.  below a filesystem
+    // node the remaining segments become the file path
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string_view workingPath{inbound->uriObj.rawPath};
+    if(workingPath.size() > 0 && workingPath[0] == '/')
+    {
+        workingPath.remove_prefix(1);
+    }
+
+    utility::parseUtilities parseUtil;
+    std::string decodedSegment;
+    uint32_t curNode{0};
+    while(workingPath.size() > 0)
+    {
+        size_t slashFound{workingPath.find('/')};
+        std::string_view rawSegment{workingPath.substr(0, slashFound)};
+        workingPath.remove_prefix(slashFound == std::string_view::npos ? workingPath.size() : slashFound + 1);
+
+        const routeNode& parentNode{this->nodes[curNode]};
+        if(parentNode.kind == enums::resourceType::FILESYSTEM)
+        {
+            parseUtil.decodeSegment(rawSegment, decodedSegment);
+            inbound->addFileSegment(decodedSegment);
+            continue;
+        }
+
+        int32_t nextNode{-1};
+        if(rawSegment.find_first_of("%+") == std::string_view::npos)
+        {
+            nextNode = this->findStatic(parentNode, rawSegment, true);
+        }
+        else
+        {
+            parseUtil.decodeSegment(rawSegment, decodedSegment);
+            nextNode = this->findStatic(parentNode, decodedSegment, false);
+        }
+        if(nextNode < 0)
+        {
+            nextNode = parentNode.dynamicNode;
+            if(nextNode < 0)
+            {
+                return(nullptr);
+            }
+            const server::resource *dynamicTarget{this->nodes[nextNode].target};
+            inbound->addPathParameter(dynamicTarget->name, rawSegment);
+            if(dynamicTarget->paramKind != enums::paramType::STRING)
+            {
+                std::string_view paramValue{rawSegment};
+                bool needsDecode{dynamicTarget->paramKind == enums::paramType::ENUMSET || dynamicTarget->paramKind == enums::paramType::REGEX};
+                if(needsDecode || rawSegment.find_first_of("%+") != std::string_view::npos)
+                {
+                    parseUtil.decodeSegment(rawSegment, decodedSegment);
+                    paramValue = decodedSegment;
+                }
+                enums::httpStatus paramStatus{server::routeTable::parseParameter(dynamicTarget, paramValue, inbound)};
+                if(paramStatus != enums::httpStatus::OK)
+                {
+                    inbound->requestStatus = paramStatus;
+                    inbound->statusReason.assign("Invalid path parameter: ");
+                    inbound->statusReason.append(dynamicTarget->name);
+                    return(nullptr);
+                }
+            }
+        }
+        curNode = static_cast<uint32_t>(nextNode);
+    }
+    return(this->nodes[curNode].target);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::routeTable::parseParameter
+///////////////////////////////////////////////////////////////////////////////
+
+enums::httpStatus server::routeTable::parseParameter(const server::resource *target, std::string_view segment, packet::httpRequest *inbound)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // malformed INT64/UUID/HEX values are a bad request.  a value outside
+    // an ENUMSET or not matching a REGEX names no resource, so not found.
+    // beyond pathValueCapacity typed values are validated but not kept
+    ///////////////////////////////////////////////////////////////////////////////
+
+    packet::httpRequest::pathValue parsed{target->name, target->paramKind, 0, 0, {}};
+
+    switch(target->paramKind)
+    {
+        case enums::paramType::INT64:
+        {
+            bool negative{segment.size() > 0 && segment[0] == '-'};
+            size_t index{negative ? static_cast<size_t>(1) : static_cast<size_t>(0)};
+            if(index == segment.size() || segment.size() - index > 19)
+            {
+                return(enums::httpStatus::BAD_REQUEST);
+            }
+            uint64_t magnitude{0};
+            for(; index < segment.size(); index++)
+            {
+                if(segment[index] < '0' || segment[index] > '9')
+                {
+                    return(enums::httpStatus::BAD_REQUEST);
+                }
+                magnitude = magnitude * 10 + static_cast<uint64_t>(segment[index] - '0');
+            }
+            uint64_t limit{negative ? static_cast<uint64_t>(INT64_MAX) + 1 : static_cast<uint64_t>(INT64_MAX)};
+            if(magnitude > limit)
+            {
+                return(enums::httpStatus::BAD_REQUEST);
+            }
+            parsed.number = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+            break;
+        }
+        case enums::paramType::HEX:
+        {
+            if(segment.size() == 0 || segment.size() > 16)
+            {
+                return(enums::httpStatus::BAD_REQUEST);
+            }
+            uint64_t bits{0};
+            for(char hexChar : segment)
+            {
+                int nibble{hexValue(hexChar)};
+                if(nibble < 0)
+                {
+                    return(enums::httpStatus::BAD_REQUEST);
+                }
+                bits = (bits << 4) | static_cast<uint64_t>(nibble);
+            }
+            parsed.bits = bits;
+            break;
+        }
+        case enums::paramType::UUID:
+        {
+            // 8-4-4-4-12 hex digits (RFC4122 [3])
+            if(segment.size() != 36)
+            {
+                return(enums::httpStatus::BAD_REQUEST);
+            }
+            size_t byteIndex{0};
+            for(size_t index = 0; index < segment.size(); index++)
+            {
+                if(index == 8 || index == 13 || index == 18 || index == 23)
+                {
+                    if(segment[index] != '-')
+                    {
+                        return(enums::httpStatus::BAD_REQUEST);
+                    }
+                    continue;
+                }
+                int highNibble{hexValue(segment[index])};
+                int lowNibble{hexValue(segment[index + 1])};
+                if(highNibble < 0 || lowNibble < 0)
+                {
+                    return(enums::httpStatus::BAD_REQUEST);
+                }
+                parsed.uuid[byteIndex++] = static_cast<uint8_t>((highNibble << 4) | lowNibble);
+                index++;
+            }
+            break;
+        }
+        case enums::paramType::ENUMSET:
+        {
+            size_t index{0};
+            while(index < target->paramChoices.size() && target->paramChoices[index] != segment)
+            {
+                index++;
+            }
+            if(index == target->paramChoices.size())
+            {
+                return(enums::httpStatus::NOT_FOUND);
+            }
+            parsed.number = static_cast<int64_t>(index);
+            break;
+        }
+        case enums::paramType::REGEX:
+        {
+            if(target->paramPattern == nullptr || !std::regex_match(segment.begin(), segment.end(), *target->paramPattern))
+            {
+                return(enums::httpStatus::NOT_FOUND);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    if(inbound->pathValueCount < packet::httpRequest::pathValueCapacity)
+    {
+        inbound->pathValues[inbound->pathValueCount++] = parsed;
+    }
+    return(enums::httpStatus::OK);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::routeTable::~routeTable()
+{
+    this->edges.clear();
+    this->nodes.clear();
+    delete this->snapshotRoot;
+    this->snapshotRoot = nullptr;
+}
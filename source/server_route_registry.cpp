@@ -0,0 +1,235 @@
+//
+// server_route_registry.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/server_resource.hpp"
+#include "../headers/server_route.hpp"
+#include "../headers/server_route_registry.hpp"
+
+namespace server = frederick2::httpServer;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// reader slots are shared by every registry in the process and handed
+// out once per thread, so the epoch counter is process wide as well
+///////////////////////////////////////////////////////////////////////////////
+
+std::atomic<uint64_t> server::routeRegistry::globalEpoch{1};
+std::mutex server::routeRegistry::slotLock;
+std::deque<server::routeRegistry::readerSlot> server::routeRegistry::slots;
+thread_local server::routeRegistry::slotOwner server::routeRegistry::localOwner;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::routeRegistry::readerSlot member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+server::routeRegistry::readerSlot::readerSlot()
+{
+    this->epoch = 0;
+    this->claimed = false;
+    this->depth = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::routeRegistry::slotOwner member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+server::routeRegistry::slotOwner::slotOwner()
+{
+    std::lock_guard<std::mutex> slotGuard(server::routeRegistry::slotLock);
+    this->slot = nullptr;
+    for(readerSlot& freeSlot : server::routeRegistry::slots)
+    {
+        if(!freeSlot.claimed.load(std::memory_order_relaxed))
+        {
+            this->slot = &freeSlot;
+            break;
+        }
+    }
+    if(this->slot == nullptr)
+    {
+        this->slot = &server::routeRegistry::slots.emplace_back();
+    }
+    this->slot->claimed.store(true, std::memory_order_relaxed);
+}
+
+server::routeRegistry::slotOwner::~slotOwner()
+{
+    std::lock_guard<std::mutex> slotGuard(server::routeRegistry::slotLock);
+    this->slot->epoch.store(0);
+    this->slot->depth = 0;
+    this->slot->claimed.store(false, std::memory_order_relaxed);
+    this->slot = nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::routeRegistry::readGuard member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+server::routeRegistry::readGuard::readGuard(server::routeRegistry *registry)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // publish the epoch before loading the table pointer.  a writer that
+    // misses this slot's epoch swapped the pointer first, so this reader
+    // is guaranteed to see the new table rather than the retired one
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->slot = server::routeRegistry::localSlot();
+    if(this->slot->depth++ == 0)
+    {
+        this->slot->epoch.store(server::routeRegistry::globalEpoch.load());
+    }
+    this->table = registry->current.load();
+}
+
+server::routeRegistry::readGuard::~readGuard()
+{
+    if(--this->slot->depth == 0)
+    {
+        this->slot->epoch.store(0, std::memory_order_release);
+    }
+    this->table = nullptr;
+    this->slot = nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::routeRegistry member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::routeRegistry::routeRegistry()
+{
+    this->current = nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::routeRegistry::localSlot
+///////////////////////////////////////////////////////////////////////////////
+
+server::routeRegistry::readerSlot* server::routeRegistry::localSlot()
+{
+    return(server::routeRegistry::localOwner.slot);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::routeRegistry::reclaim
+///////////////////////////////////////////////////////////////////////////////
+
+void server::routeRegistry::reclaim()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // a table retired at epoch E can only still be held by readers that
+    // entered at or before E.  free everything older than the oldest
+    // active reader.  caller holds writeLock
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->retired.size() == 0)
+    {
+        return;
+    }
+
+    uint64_t oldestActive{UINT64_MAX};
+    {
+        std::lock_guard<std::mutex> slotGuard(server::routeRegistry::slotLock);
+        for(readerSlot& activeSlot : server::routeRegistry::slots)
+        {
+            uint64_t slotEpoch{activeSlot.epoch.load()};
+            if(slotEpoch != 0 && slotEpoch < oldestActive)
+            {
+                oldestActive = slotEpoch;
+            }
+        }
+    }
+
+    auto retiredIter{this->retired.begin()};
+    while(retiredIter != this->retired.end())
+    {
+        if(retiredIter->first < oldestActive)
+        {
+            delete retiredIter->second;
+            retiredIter = this->retired.erase(retiredIter);
+        }
+        else
+        {
+            retiredIter++;
+        }
+    }
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::routeRegistry::update
+///////////////////////////////////////////////////////////////////////////////
+
+void server::routeRegistry::update
+(server::resource *draftRoot, const std::function<void(server::resource*)>& editRoutes, const std::function<void(server::routeTable*)>& prepareTable)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // writers are serialized on writeLock and edit the draft tree, which
+    // readers never touch.  the new table copies the draft so the
+    // published snapshot stays immutable; prepareTable gets the one
+    // chance to fill in per route state before it is published
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::lock_guard<std::mutex> writeGuard(this->writeLock);
+    if(editRoutes)
+    {
+        editRoutes(draftRoot);
+    }
+
+    server::routeTable *newTable{new server::routeTable(draftRoot)};
+    if(prepareTable)
+    {
+        prepareTable(newTable);
+    }
+    server::routeTable *oldTable{this->current.exchange(newTable)};
+    if(oldTable != nullptr)
+    {
+        this->retired.emplace_back(server::routeRegistry::globalEpoch.fetch_add(1), oldTable);
+    }
+    this->reclaim();
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::routeRegistry::~routeRegistry()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // the owning server has stopped, no readers remain
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::lock_guard<std::mutex> writeGuard(this->writeLock);
+    for(std::pair<uint64_t, server::routeTable*>& retiredTable : this->retired)
+    {
+        delete retiredTable.second;
+    }
+    this->retired.clear();
+    delete this->current.exchange(nullptr);
+}
@@ -163,7 +163,16 @@ server::socket::socket(int curFD)
 
 void server::socket::close()
 {
-    ::close(this->sock);
+    ///////////////////////////////////////////////////////////////////////////////
+    // descriptor is forgotten once closed so the destructor cannot close
+    // a number the kernel has since handed to another connection
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->sock >= 0)
+    {
+        ::close(this->sock);
+        this->sock = -1;
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -241,5 +250,5 @@ void server::socket::shutdown(bool shutRead, bool shutWrite)
 
 server::socket::~socket()
 {
-    ::close(this->sock);
+    this->close();
 }
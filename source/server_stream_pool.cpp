@@ -0,0 +1,133 @@
+//
+// server_stream_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/server_stream_pool.hpp"
+
+namespace server = frederick2::httpServer;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::streamPool member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::streamPool::streamPool(size_t threadCount, size_t queueLimit)
+{
+    this->stopping = false;
+    this->maxQueue = queueLimit;
+    this->queuePeak = 0;
+    for(size_t index = 0; index < threadCount; index++)
+    {
+        this->workers.push_back(std::thread(&server::streamPool::workerLoop, this));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::streamPool::getQueueDepth
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::streamPool::getQueueDepth()
+{
+    std::lock_guard<std::mutex> lockPool(this->poolLock);
+    return(this->pending.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::streamPool::submit
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::streamPool::submit(streamTask& newTask)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // the task is only taken when there is room.  a full queue leaves it
+    // with the caller, whose session offers it again on its next pass
+    ///////////////////////////////////////////////////////////////////////////////
+
+    {
+        std::lock_guard<std::mutex> lockPool(this->poolLock);
+        if(this->stopping || this->pending.size() >= this->maxQueue)
+        {
+            return(false);
+        }
+        this->pending.push_back(std::move(newTask));
+        if(this->pending.size() > this->queuePeak)
+        {
+            this->queuePeak = this->pending.size();
+        }
+    }
+    this->taskReady.notify_one();
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::streamPool::workerLoop
+///////////////////////////////////////////////////////////////////////////////
+
+void server::streamPool::workerLoop()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // handler exceptions are captured in the task's future, so a worker
+    // only leaves once stopping is set and the queue has drained
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::unique_lock<std::mutex> lockPool(this->poolLock);
+    while(true)
+    {
+        this->taskReady.wait(lockPool, [this]{return(this->stopping || this->pending.size() > 0);});
+        if(this->pending.size() == 0)
+        {
+            return;
+        }
+
+        streamTask curTask{std::move(this->pending.front())};
+        this->pending.pop_front();
+        lockPool.unlock();
+        curTask();
+        lockPool.lock();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::streamPool::~streamPool()
+{
+    {
+        std::lock_guard<std::mutex> lockPool(this->poolLock);
+        this->stopping = true;
+    }
+    this->taskReady.notify_all();
+    for(std::thread& worker : this->workers)
+    {
+        if(worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
@@ -0,0 +1,202 @@
+//
+// server_tickets.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/params.h>
+#include <openssl/rand.h>
+#include <openssl/ssl.h>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/server_tickets.hpp"
+
+namespace server = frederick2::httpServer;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int server::ticketKeys::exDataIndex{-1};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::ticketKeys member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::ticketKeys::ticketKeys(size_t rotation)
+{
+    this->rotationSeconds = rotation;
+    this->currentKey.valid = false;
+    this->previousKey.valid = false;
+    this->rotate();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::ticketKeys::attach
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::ticketKeys::attach(SSL_CTX *context)
+{
+    if(server::ticketKeys::exDataIndex < 0)
+    {
+        server::ticketKeys::exDataIndex = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    }
+    if(server::ticketKeys::exDataIndex < 0 || !this->currentKey.valid)
+    {
+        return(false);
+    }
+    if(SSL_CTX_set_ex_data(context, server::ticketKeys::exDataIndex, this) != 1)
+    {
+        return(false);
+    }
+    return(SSL_CTX_set_tlsext_ticket_key_evp_cb(context, &server::ticketKeys::ticketCallback) == 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::ticketKeys::generateKey
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::ticketKeys::generateKey(ticketKey& newKey)
+{
+    bool returnValue{RAND_bytes(newKey.name, sizeof(newKey.name)) == 1};
+    returnValue &= RAND_priv_bytes(newKey.aesKey, sizeof(newKey.aesKey)) == 1;
+    returnValue &= RAND_priv_bytes(newKey.hmacKey, sizeof(newKey.hmacKey)) == 1;
+    newKey.valid = returnValue;
+    return(returnValue);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::ticketKeys::rotate
+///////////////////////////////////////////////////////////////////////////////
+
+void server::ticketKeys::rotate()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // caller holds keyLock (or is the constructor)
+    // the outgoing key keeps decrypting for one more period so tickets issued
+    // just before rotation still resume
+    ///////////////////////////////////////////////////////////////////////////////
+
+    ticketKey newKey;
+    if(!this->generateKey(newKey))
+    {
+        return;
+    }
+    this->previousKey = this->currentKey;
+    this->currentKey = newKey;
+    OPENSSL_cleanse(&newKey, sizeof(newKey));
+    this->rotatedAt = std::chrono::steady_clock::now();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::ticketKeys::setMacKey
+///////////////////////////////////////////////////////////////////////////////
+
+bool server::ticketKeys::setMacKey(EVP_MAC_CTX *macContext, unsigned char *hmacKey)
+{
+    char digestName[]{"SHA256"};
+    OSSL_PARAM macParams[3];
+    macParams[0] = OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, hmacKey, 32);
+    macParams[1] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digestName, 0);
+    macParams[2] = OSSL_PARAM_construct_end();
+    return(EVP_MAC_CTX_set_params(macContext, macParams) == 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::ticketKeys::ticketCallback
+///////////////////////////////////////////////////////////////////////////////
+
+int server::ticketKeys::ticketCallback
+(SSL *sslConnection, unsigned char *keyName, unsigned char *iv, EVP_CIPHER_CTX *cipherContext, EVP_MAC_CTX *macContext, int encrypt)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // return values per SSL_CTX_set_tlsext_ticket_key_evp_cb
+    // -1 error, 0 unknown key (full handshake), 1 ok, 2 ok but reissue ticket
+    ///////////////////////////////////////////////////////////////////////////////
+
+    SSL_CTX *context{SSL_get_SSL_CTX(sslConnection)};
+    server::ticketKeys *keys{static_cast<server::ticketKeys*>(SSL_CTX_get_ex_data(context, server::ticketKeys::exDataIndex))};
+    if(keys == nullptr)
+    {
+        return(-1);
+    }
+
+    std::lock_guard<std::mutex> lockKeys(keys->keyLock);
+
+    if(encrypt == 1)
+    {
+        auto keyAge{std::chrono::steady_clock::now() - keys->rotatedAt};
+        if(keys->rotationSeconds > 0 && keyAge > std::chrono::seconds(keys->rotationSeconds))
+        {
+            keys->rotate();
+        }
+        if(RAND_bytes(iv, EVP_CIPHER_get_iv_length(EVP_aes_256_cbc())) != 1)
+        {
+            return(-1);
+        }
+        memcpy(keyName, keys->currentKey.name, sizeof(keys->currentKey.name));
+        if(EVP_EncryptInit_ex(cipherContext, EVP_aes_256_cbc(), nullptr, keys->currentKey.aesKey, iv) != 1)
+        {
+            return(-1);
+        }
+        if(!server::ticketKeys::setMacKey(macContext, keys->currentKey.hmacKey))
+        {
+            return(-1);
+        }
+        return(1);
+    }
+
+    ticketKey *matchKey{nullptr};
+    int returnValue{0};
+    if(keys->currentKey.valid && memcmp(keyName, keys->currentKey.name, sizeof(keys->currentKey.name)) == 0)
+    {
+        matchKey = &keys->currentKey;
+        returnValue = 1;
+    }
+    else if(keys->previousKey.valid && memcmp(keyName, keys->previousKey.name, sizeof(keys->previousKey.name)) == 0)
+    {
+        matchKey = &keys->previousKey;
+        returnValue = 2;
+    }
+    if(matchKey == nullptr)
+    {
+        return(0);
+    }
+
+    if(EVP_DecryptInit_ex(cipherContext, EVP_aes_256_cbc(), nullptr, matchKey->aesKey, iv) != 1)
+    {
+        return(-1);
+    }
+    if(!server::ticketKeys::setMacKey(macContext, matchKey->hmacKey))
+    {
+        return(-1);
+    }
+    return(returnValue);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+server::ticketKeys::~ticketKeys()
+{
+    OPENSSL_cleanse(&this->currentKey, sizeof(this->currentKey));
+    OPENSSL_cleanse(&this->previousKey, sizeof(this->previousKey));
+}
@@ -10,14 +10,17 @@
 #include <map>
 #include <queue>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../headers/frederick2_namespace.hpp"
 #include "../headers/server_enum.hpp"
 #include "../headers/server_uri.hpp"
+#include "../headers/utility_parse.hpp"
 
 namespace enums = frederick2::httpEnums;
 namespace server = frederick2::httpServer;
+namespace utility = frederick2::utility;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // global variable definitions
@@ -53,7 +56,7 @@ server::uri::uri()
 // frederick2::httpServer::uri::getFragments
 ///////////////////////////////////////////////////////////////////////////////
 
-std::vector<std::string> server::uri::getFragments()
+const std::vector<std::string>& server::uri::getFragments() const
 {
     return(this->fragments);
 }
@@ -62,7 +65,7 @@ std::vector<std::string> server::uri::getFragments()
 // frederick2::httpServer::uri::getFragmentString
 ///////////////////////////////////////////////////////////////////////////////
 
-std::string server::uri::getFragmentString()
+const std::string& server::uri::getFragmentString() const
 {
     return(this->fullFragmentString);
 }
@@ -71,7 +74,7 @@ std::string server::uri::getFragmentString()
 // frederick2::httpServer::uri::getParameters
 ///////////////////////////////////////////////////////////////////////////////
 
-strMAPstr server::uri::getParameters()
+const strMAPstr& server::uri::getParameters() const
 {
     return(this->parameters);
 }
@@ -80,7 +83,7 @@ strMAPstr server::uri::getParameters()
 // frederick2::httpServer::uri::getParameterString
 ///////////////////////////////////////////////////////////////////////////////
 
-std::string server::uri::getParameterString()
+const std::string& server::uri::getParameterString() const
 {
     return(this->fullParameterString);
 }
@@ -89,7 +92,7 @@ std::string server::uri::getParameterString()
 // frederick2::httpServer::uri::getHost
 ///////////////////////////////////////////////////////////////////////////////
 
-std::string server::uri::getHost()
+const std::string& server::uri::getHost() const
 {
     return(this->host);
 }
@@ -98,7 +101,7 @@ std::string server::uri::getHost()
 // frederick2::httpServer::uri::getHostType
 ///////////////////////////////////////////////////////////////////////////////
 
-frederick2::httpEnums::uriHostType server::uri::getHostType()
+frederick2::httpEnums::uriHostType server::uri::getHostType() const
 {
     return(this->hostType);
 }
@@ -107,7 +110,7 @@ frederick2::httpEnums::uriHostType server::uri::getHostType()
 // frederick2::httpServer::uri::getPassword
 ///////////////////////////////////////////////////////////////////////////////
 
-std::string server::uri::getPassword()
+const std::string& server::uri::getPassword() const
 {
     return(this->password);
 }
@@ -116,16 +119,17 @@ std::string server::uri::getPassword()
 // frederick2::httpServer::uri::getPathString
 ///////////////////////////////////////////////////////////////////////////////
 
-std::string server::uri::getPathString()
+std::string server::uri::getPathString() const
 {
     std::string returnString;
-    if(this->segments.size() == 0)
+    const std::deque<std::string>& pathSegments{this->getSegments()};
+    if(pathSegments.size() == 0)
     {
         returnString.append("/");
     }
     else
     {
-        for(auto index = this->segments.cbegin(); index != this->segments.cend(); index++)
+        for(auto index = pathSegments.cbegin(); index != pathSegments.cend(); index++)
         {
             returnString.append("/");
             returnString.append(*index);
@@ -134,11 +138,20 @@ std::string server::uri::getPathString()
     return(returnString);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::uri::getRawPath
+///////////////////////////////////////////////////////////////////////////////
+
+const std::string& server::uri::getRawPath() const
+{
+    return(this->rawPath);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::uri::getPort
 ///////////////////////////////////////////////////////////////////////////////
 
-int server::uri::getPort()
+int server::uri::getPort() const
 {
     return(this->port);
 }
@@ -147,7 +160,7 @@ int server::uri::getPort()
 // frederick2::httpServer::uri::getScheme
 ///////////////////////////////////////////////////////////////////////////////
 
-frederick2::httpEnums::uriScheme server::uri::getScheme()
+frederick2::httpEnums::uriScheme server::uri::getScheme() const
 {
     return(this->scheme);
 }
@@ -156,16 +169,48 @@ frederick2::httpEnums::uriScheme server::uri::getScheme()
 // frederick2::httpServer::uri::getSegments
 ///////////////////////////////////////////////////////////////////////////////
 
-std::deque<std::string> server::uri::getSegments()
+const std::deque<std::string>& server::uri::getSegments() const
 {
-    return(this->segments);
+    ///////////////////////////////////////////////////////////////////////////////
+    // parsed requests only keep the raw path; segments are decoded into
+    // the member on first use and returned by reference from then on.
+    // the deque is only built when asked for, since an empty std::deque
+    // still allocates and most requests never look at it
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->segments.has_value())
+    {
+        return(*this->segments);
+    }
+
+    this->segments.emplace();
+    if(!this->pathProvided)
+    {
+        return(*this->segments);
+    }
+    this->segments->push_back("RESOURCE_ROOT");
+    utility::parseUtilities parseUtil;
+    std::string_view workingPath{this->rawPath};
+    if(workingPath.size() > 0 && workingPath[0] == '/')
+    {
+        workingPath.remove_prefix(1);
+    }
+    while(workingPath.size() > 0)
+    {
+        size_t slashFound{workingPath.find('/')};
+        std::string segment;
+        parseUtil.decodeSegment(workingPath.substr(0, slashFound), segment);
+        this->segments->push_back(std::move(segment));
+        workingPath.remove_prefix(slashFound == std::string_view::npos ? workingPath.size() : slashFound + 1);
+    }
+    return(*this->segments);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::uri::getURIString
 ///////////////////////////////////////////////////////////////////////////////
 
-std::string server::uri::getURIString()
+const std::string& server::uri::getURIString() const
 {
     return(this->fullURIString);
 }
@@ -174,7 +219,7 @@ std::string server::uri::getURIString()
 // frederick2::httpServer::uri::getUsername
 ///////////////////////////////////////////////////////////////////////////////
 
-std::string server::uri::getUsername()
+const std::string& server::uri::getUsername() const
 {
     return(this->username);
 }
@@ -183,7 +228,7 @@ std::string server::uri::getUsername()
 // frederick2::httpServer::uri::hasFragments
 ///////////////////////////////////////////////////////////////////////////////
 
-bool server::uri::hasFragments()
+bool server::uri::hasFragments() const
 {
     return(this->fragmentProvided);
 }
@@ -192,7 +237,7 @@ bool server::uri::hasFragments()
 // frederick2::httpServer::uri::hasHost
 ///////////////////////////////////////////////////////////////////////////////
 
-bool server::uri::hasHost()
+bool server::uri::hasHost() const
 {
     return(this->hostProvided);
 }
@@ -201,7 +246,7 @@ bool server::uri::hasHost()
 // frederick2::httpServer::uri::hasParameters
 ///////////////////////////////////////////////////////////////////////////////
 
-bool server::uri::hasParameters()
+bool server::uri::hasParameters() const
 {
     return(this->parametersProvided);
 }
@@ -210,7 +255,7 @@ bool server::uri::hasParameters()
 // frederick2::httpServer::uri::hasPath
 ///////////////////////////////////////////////////////////////////////////////
 
-bool server::uri::hasPath()
+bool server::uri::hasPath() const
 {
     return(this->pathProvided);
 }
@@ -219,7 +264,7 @@ bool server::uri::hasPath()
 // frederick2::httpServer::uri::hasPort
 ///////////////////////////////////////////////////////////////////////////////
 
-bool server::uri::hasPort()
+bool server::uri::hasPort() const
 {
     return(this->portProvided);
 }
@@ -228,7 +273,7 @@ bool server::uri::hasPort()
 // frederick2::httpServer::uri::hasScheme
 ///////////////////////////////////////////////////////////////////////////////
 
-bool server::uri::hasScheme()
+bool server::uri::hasScheme() const
 {
     return(this->schemeProvided);
 }
@@ -237,7 +282,7 @@ bool server::uri::hasScheme()
 // frederick2::httpServer::uri::hasUserInfo
 ///////////////////////////////////////////////////////////////////////////////
 
-bool server::uri::hasUserInfo()
+bool server::uri::hasUserInfo() const
 {
     return(this->userInfoProvided);
 }
@@ -281,7 +326,11 @@ void server::uri::addParameter(const std::string& pName, const std::string& pVal
 
 void server::uri::addSegment(const std::string& sName)
 {
-    this->segments.push_back(sName);
+    if(!this->segments.has_value())
+    {
+        this->segments.emplace();
+    }
+    this->segments->push_back(sName);
     this->pathProvided = true;
     return;
 }
@@ -348,6 +397,18 @@ void server::uri::setPort(int inPort)
     return;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::uri::setRawPath
+///////////////////////////////////////////////////////////////////////////////
+
+void server::uri::setRawPath(const std::string& path)
+{
+    this->rawPath = path;
+    this->pathProvided = true;
+    this->segments.reset();
+    return;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::httpServer::uri::setScheme
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,76 @@
+//
+// utility_arena.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/utility_arena.hpp"
+
+namespace utility = frederick2::utility;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::requestArena member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+utility::requestArena::requestArena()
+    : block{new std::byte[utility::requestArena::blockSize]},
+      monotonic{block.get(), utility::requestArena::blockSize, std::pmr::new_delete_resource()}
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // a typical request fits the inline block.  anything larger spills to
+    // the heap and is returned when the arena is rewound.  an arena belongs
+    // to one request for life and is pooled along with it
+    ///////////////////////////////////////////////////////////////////////////////
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::requestArena::getResource
+///////////////////////////////////////////////////////////////////////////////
+
+std::pmr::memory_resource* utility::requestArena::getResource()
+{
+    return(&this->monotonic);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::requestArena::rewind
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::requestArena::rewind()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // drops everything allocated so far; containers built on the arena
+    // must already be empty and hold no capacity
+    ///////////////////////////////////////////////////////////////////////////////
+
+    this->monotonic.release();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+utility::requestArena::~requestArena()
+{
+    this->monotonic.release();
+}
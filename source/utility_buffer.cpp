@@ -9,6 +9,7 @@
 
 #include <chrono>
 #include <string>
+#include <string_view>
 #include "../headers/frederick2_namespace.hpp"
 #include "../headers/utility_buffer.hpp"
 
@@ -72,7 +73,7 @@ enums::httpStatus utility::bufferStringReader::extractFixedSize
         }
         else if(curSize < contentRemaining)
         {
-            contentData.append(this->buffer->substr(0, curSize));
+            contentData.append(*this->buffer, 0, curSize);
             this->buffer->erase(0, curSize);
             received += curSize;
             contentRemaining = contentLength - contentData.size();
@@ -80,7 +81,7 @@ enums::httpStatus utility::bufferStringReader::extractFixedSize
         }
         else
         {
-            contentData.append(this->buffer->substr(0, contentRemaining));
+            contentData.append(*this->buffer, 0, contentRemaining);
             this->buffer->erase(0, contentRemaining);
             received += contentRemaining;
             contentRemaining = contentLength - contentData.size();
@@ -146,39 +147,40 @@ enums::httpStatus utility::bufferStringReader::extractSingleLine
     
     ///////////////////////////////////////////////////////////////////////////////
     // Max implemented Request Line size is maxSize
-    // Copy data from buffer into workingLine until
-    // EoL found or workingLine size exceeds maxSize
+    // Copy data from buffer into workingLine (the caller's string, so
+    // its capacity is reused) until EoL found or size exceeds maxSize
     ///////////////////////////////////////////////////////////////////////////////
     
-    std::string workingLine;
+    std::string& workingLine{outString};
+    workingLine.clear();
     size_t workingSize{workingLine.size()};
     received = 0;
 
     size_t endlFound{std::string::npos};
     while(!timeout && endlFound == std::string::npos && workingSize < maxSize)
     {
-        std::string maxSearchString;
+        ///////////////////////////////////////////////////////////////////////////////
+        // search a view of the buffer and copy straight into workingLine;
+        // no temporaries are built per pass
+        ///////////////////////////////////////////////////////////////////////////////
+
         size_t searchSize = maxSize - workingSize;
-        size_t bufferSize{this->buffer->size()};
-        if(bufferSize >= searchSize)
-        {
-            maxSearchString = this->buffer->substr(0, searchSize);
-            endlFound = maxSearchString.find("\r\n");
-        }
-        else
+        std::string_view maxSearchView{*this->buffer};
+        if(maxSearchView.size() > searchSize)
         {
-            maxSearchString = this->buffer->substr(0, bufferSize);
-            endlFound = maxSearchString.find("\r\n");
+            maxSearchView = maxSearchView.substr(0, searchSize);
         }
+        endlFound = maxSearchView.find("\r\n");
         if(endlFound == std::string::npos)
         {
-            workingLine.append(this->buffer->substr(0, maxSearchString.size()));
-            this->buffer->erase(0, maxSearchString.size());
-            received += maxSearchString.size();
+            size_t searchLength{maxSearchView.size()};
+            workingLine.append(*this->buffer, 0, searchLength);
+            this->buffer->erase(0, searchLength);
+            received += searchLength;
         }
         else
         {
-            workingLine.append(this->buffer->substr(0,endlFound));
+            workingLine.append(*this->buffer, 0, endlFound);
             this->buffer->erase(0, endlFound + 2);
             received += endlFound + 2;
         }
@@ -212,7 +214,6 @@ enums::httpStatus utility::bufferStringReader::extractSingleLine
         return(enums::httpStatus::BAD_REQUEST);
     }
 
-    outString = std::move(workingLine);
     return(enums::httpStatus::OK);
 }
 
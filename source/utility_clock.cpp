@@ -0,0 +1,105 @@
+//
+// utility_clock.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/utility_clock.hpp"
+
+namespace utility = frederick2::utility;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// invariantTSC is defined first so baseline's ticks use the same source
+///////////////////////////////////////////////////////////////////////////////
+
+const bool utility::cycleClock::invariantTSC{utility::cycleClock::detectInvariantTSC()};
+const utility::cycleClock::clockPair utility::cycleClock::baseline;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::cycleClock::clockPair member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+utility::cycleClock::clockPair::clockPair()
+{
+    this->ticks = utility::cycleClock::now();
+    this->steady = std::chrono::steady_clock::now();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::cycleClock member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::cycleClock::detectInvariantTSC
+///////////////////////////////////////////////////////////////////////////////
+
+bool utility::cycleClock::detectInvariantTSC()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // CPUID leaf 0x80000007 EDX bit 8: the TSC ticks at a constant rate
+    // across P-, C- and T-states.  without it rdtsc can drift with
+    // frequency changes, so stage timing falls back to steady_clock
+    ///////////////////////////////////////////////////////////////////////////////
+
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax{0};
+    unsigned int ebx{0};
+    unsigned int ecx{0};
+    unsigned int edx{0};
+    if(__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0)
+    {
+        return(false);
+    }
+    return((edx & (1u << 8)) != 0);
+#else
+    return(false);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::cycleClock::secondsPerTick
+///////////////////////////////////////////////////////////////////////////////
+
+double utility::cycleClock::secondsPerTick()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // calibrated against steady_clock over the whole time since startup, so
+    // the ratio only gets more precise the longer the process runs.  too
+    // soon after startup, wait out a short window first.  the steady_clock
+    // fallback already counts nanoseconds
+    ///////////////////////////////////////////////////////////////////////////////
+
+#if defined(__x86_64__) || defined(__i386__)
+    if(utility::cycleClock::invariantTSC)
+    {
+        std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - utility::cycleClock::baseline.steady};
+        if(elapsed.count() < 0.01)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            elapsed = std::chrono::steady_clock::now() - utility::cycleClock::baseline.steady;
+        }
+        uint64_t tickCount{utility::cycleClock::now() - utility::cycleClock::baseline.ticks};
+        if(tickCount > 0)
+        {
+            return(elapsed.count() / static_cast<double>(tickCount));
+        }
+    }
+#endif
+    return(1e-9);
+}
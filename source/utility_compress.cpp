@@ -0,0 +1,270 @@
+//
+// utility_compress.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <exception>
+#include <string>
+#include <zlib.h>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/server_enum.hpp"
+#include "../headers/utility_compress.hpp"
+#include "../headers/utility_parse.hpp"
+
+namespace enums = frederick2::httpEnums;
+namespace utility = frederick2::utility;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// one reusable deflate state per coding per thread.  deflateInit2 allocates
+// ~256KB of window/hash memory so it is done once and deflateReset is used
+// between responses
+///////////////////////////////////////////////////////////////////////////////
+
+thread_local utility::compressor::deflateState utility::compressor::gzipState;
+thread_local utility::compressor::deflateState utility::compressor::zlibState;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::compressor::deflateState member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+utility::compressor::deflateState::deflateState()
+{
+    this->ready = false;
+    memset(&this->stream, 0, sizeof(z_stream));
+}
+
+utility::compressor::deflateState::~deflateState()
+{
+    if(this->ready)
+    {
+        deflateEnd(&this->stream);
+        this->ready = false;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::compressor member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+utility::compressor::compressor(enums::contentCoding targetCoding)
+{
+    this->coding = targetCoding;
+    this->stream = utility::compressor::acquireStream(targetCoding);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::compressor::acquireStream
+///////////////////////////////////////////////////////////////////////////////
+
+z_stream *utility::compressor::acquireStream(enums::contentCoding targetCoding)
+{
+    deflateState *state{nullptr};
+    int windowBits{15};
+    switch(targetCoding)
+    {
+        case enums::contentCoding::GZIP:
+            state = &utility::compressor::gzipState;
+            windowBits += 16;
+            break;
+        case enums::contentCoding::DEFLATE:
+            state = &utility::compressor::zlibState;
+            break;
+        default:
+            return(nullptr);
+    }
+
+    if(!state->ready)
+    {
+        int initResult{deflateInit2(&state->stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY)};
+        if(initResult != Z_OK)
+        {
+            return(nullptr);
+        }
+        state->ready = true;
+    }
+    else if(deflateReset(&state->stream) != Z_OK)
+    {
+        return(nullptr);
+    }
+
+    return(&state->stream);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::compressor::coding2str
+///////////////////////////////////////////////////////////////////////////////
+
+std::string utility::compressor::coding2str(enums::contentCoding targetCoding)
+{
+    switch(targetCoding)
+    {
+        case enums::contentCoding::GZIP:
+            return("gzip");
+        case enums::contentCoding::DEFLATE:
+            return("deflate");
+        case enums::contentCoding::IDENTITY:
+            return("identity");
+        default:
+            return("");
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::compressor::compress
+///////////////////////////////////////////////////////////////////////////////
+
+bool utility::compressor::compress(const std::string& original, strVECTOR& blocks, size_t blockSize)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // stream the input through deflate, emitting one output block each time
+    // blockSize bytes of compressed data are produced
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->stream == nullptr || blockSize == 0)
+    {
+        return(false);
+    }
+
+    blocks.clear();
+    this->stream->next_in = (Bytef*)original.data();
+    this->stream->avail_in = original.size();
+
+    int deflateResult{Z_OK};
+    while(deflateResult == Z_OK)
+    {
+        std::string block(blockSize, '\0');
+        this->stream->next_out = (Bytef*)&block[0];
+        this->stream->avail_out = blockSize;
+        deflateResult = deflate(this->stream, Z_FINISH);
+        if(deflateResult == Z_STREAM_ERROR)
+        {
+            return(false);
+        }
+        block.resize(blockSize - this->stream->avail_out);
+        if(block.size() > 0)
+        {
+            blocks.push_back(std::move(block));
+        }
+    }
+
+    return(deflateResult == Z_STREAM_END);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::compressor::negotiate
+///////////////////////////////////////////////////////////////////////////////
+
+enums::contentCoding utility::compressor::negotiate(const std::string& acceptEncoding)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // pick the highest weighted of gzip / deflate (RFC7231 [5.3.4])
+    // ties go to gzip.  "*" applies to any coding not explicitly listed
+    ///////////////////////////////////////////////////////////////////////////////
+
+    utility::parseUtilities parseUtil;
+    std::string wspChars{" \t"};
+    std::string workingStr;
+    parseUtil.toLower(acceptEncoding, workingStr);
+
+    double gzipWeight{-1.0};
+    double deflateWeight{-1.0};
+    double starWeight{-1.0};
+
+    size_t startPos{0};
+    while(startPos < workingStr.size())
+    {
+        size_t commaFound{workingStr.find_first_of(',', startPos)};
+        if(commaFound == std::string::npos)
+        {
+            commaFound = workingStr.size();
+        }
+        std::string element{workingStr.substr(startPos, commaFound - startPos)};
+        startPos = commaFound + 1;
+
+        double weight{1.0};
+        size_t semiFound{element.find_first_of(';')};
+        if(semiFound != std::string::npos)
+        {
+            size_t qFound{element.find("q=", semiFound)};
+            if(qFound != std::string::npos)
+            {
+                try
+                {
+                    weight = std::stod(element.substr(qFound + 2));
+                }
+                catch(const std::exception& e)
+                {
+                    weight = 0.0;
+                }
+            }
+            element.erase(semiFound);
+        }
+
+        size_t firstFound{element.find_first_not_of(wspChars)};
+        if(firstFound == std::string::npos)
+        {
+            continue;
+        }
+        size_t lastFound{element.find_last_not_of(wspChars)};
+        element = element.substr(firstFound, (lastFound - firstFound) + 1);
+
+        if(element == "gzip" || element == "x-gzip")
+        {
+            gzipWeight = weight;
+        }
+        else if(element == "deflate")
+        {
+            deflateWeight = weight;
+        }
+        else if(element == "*")
+        {
+            starWeight = weight;
+        }
+    }
+
+    if(gzipWeight < 0.0)
+    {
+        gzipWeight = starWeight;
+    }
+    if(deflateWeight < 0.0)
+    {
+        deflateWeight = starWeight;
+    }
+
+    if(gzipWeight > 0.0 && gzipWeight >= deflateWeight)
+    {
+        return(enums::contentCoding::GZIP);
+    }
+    if(deflateWeight > 0.0)
+    {
+        return(enums::contentCoding::DEFLATE);
+    }
+    return(enums::contentCoding::IDENTITY);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+utility::compressor::~compressor()
+{
+    this->stream = nullptr;
+}
@@ -0,0 +1,119 @@
+//
+// utility_header.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/utility_header.hpp"
+
+namespace utility = frederick2::utility;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// constant part of every response header block, serialized once
+///////////////////////////////////////////////////////////////////////////////
+
+static const std::string commonHeaderPrefix{"Server: frederick2\r\n"};
+static const char *dayNames[]{"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+static const char *monthNames[]{"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+thread_local utility::headerCache::dateState utility::headerCache::localState;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerCache::dateState member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+utility::headerCache::dateState::dateState()
+{
+    this->lastSecond = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerCache member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerCache::appendCommonHeaders
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::headerCache::appendCommonHeaders(std::string& headerLines, bool withServer, bool withDate)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // either field is left out when the response already carries its own
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(withServer && withDate)
+    {
+        const dateState& state{utility::headerCache::refresh()};
+        headerLines.append(state.headerBlock);
+        return;
+    }
+    if(withServer)
+    {
+        headerLines.append(commonHeaderPrefix);
+    }
+    if(withDate)
+    {
+        const dateState& state{utility::headerCache::refresh()};
+        headerLines.append(state.headerBlock, commonHeaderPrefix.size(), std::string::npos);
+    }
+    return;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerCache::getDate
+///////////////////////////////////////////////////////////////////////////////
+
+const std::string& utility::headerCache::getDate()
+{
+    return(utility::headerCache::refresh().dateValue);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerCache::refresh
+///////////////////////////////////////////////////////////////////////////////
+
+utility::headerCache::dateState& utility::headerCache::refresh()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // IMF-fixdate (RFC7231 [7.1.1.1]) only changes once per second
+    // so it is formatted at most once per second per thread
+    ///////////////////////////////////////////////////////////////////////////////
+
+    dateState& state{utility::headerCache::localState};
+    time_t curSecond{time(nullptr)};
+    if(curSecond == state.lastSecond)
+    {
+        return(state);
+    }
+
+    struct tm utcTime;
+    gmtime_r(&curSecond, &utcTime);
+    char dateBuffer[32];
+    snprintf(dateBuffer, sizeof(dateBuffer), "%s, %02d %s %04d %02d:%02d:%02d GMT",
+        dayNames[utcTime.tm_wday], utcTime.tm_mday, monthNames[utcTime.tm_mon], utcTime.tm_year + 1900,
+        utcTime.tm_hour, utcTime.tm_min, utcTime.tm_sec);
+
+    state.lastSecond = curSecond;
+    state.dateValue.assign(dateBuffer);
+    state.headerBlock.assign(commonHeaderPrefix);
+    state.headerBlock.append("Date: ");
+    state.headerBlock.append(state.dateValue);
+    state.headerBlock.append("\r\n");
+    return(state);
+}
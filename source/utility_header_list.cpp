@@ -0,0 +1,327 @@
+//
+// utility_header_list.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/utility_header_list.hpp"
+
+namespace utility = frederick2::utility;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+utility::headerList::headerList()
+{
+    this->entryCount = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::append
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::headerList::append(const std::string& hName, const std::string& hValue)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // first inlineCapacity entries live inside the object
+    // only unusually large header sets touch the overflow vector
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->entryCount < utility::headerList::inlineCapacity)
+    {
+        headerEntry& target{this->inlineEntries[this->entryCount]};
+        target.name.assign(hName);
+        target.value.assign(hValue);
+    }
+    else
+    {
+        this->overflowEntries.push_back(headerEntry{hName, hValue});
+    }
+    this->entryCount++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::clear
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::headerList::clear()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // inline strings keep their capacity so a reused list does not reallocate
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t inlineUsed{this->entryCount < utility::headerList::inlineCapacity ? this->entryCount : utility::headerList::inlineCapacity};
+    for(size_t index = 0; index < inlineUsed; index++)
+    {
+        this->inlineEntries[index].name.clear();
+        this->inlineEntries[index].value.clear();
+    }
+    this->overflowEntries.clear();
+    this->entryCount = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::collectNames
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::headerList::collectNames(std::vector<std::string>& target) const
+{
+    for(size_t index = 0; index < this->entryCount; index++)
+    {
+        target.push_back(this->entryAt(index).name);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::entryAt
+///////////////////////////////////////////////////////////////////////////////
+
+utility::headerList::headerEntry& utility::headerList::entryAt(size_t index)
+{
+    if(index < utility::headerList::inlineCapacity)
+    {
+        return(this->inlineEntries[index]);
+    }
+    return(this->overflowEntries[index - utility::headerList::inlineCapacity]);
+}
+
+const utility::headerList::headerEntry& utility::headerList::entryAt(size_t index) const
+{
+    if(index < utility::headerList::inlineCapacity)
+    {
+        return(this->inlineEntries[index]);
+    }
+    return(this->overflowEntries[index - utility::headerList::inlineCapacity]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::find
+///////////////////////////////////////////////////////////////////////////////
+
+const std::string *utility::headerList::find(const std::string& hName) const
+{
+    for(size_t index = 0; index < this->entryCount; index++)
+    {
+        const headerEntry& current{this->entryAt(index)};
+        if(utility::headerList::nameEquals(current.name, hName))
+        {
+            return(&current.value);
+        }
+    }
+    return(nullptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::has
+///////////////////////////////////////////////////////////////////////////////
+
+bool utility::headerList::has(const std::string& hName) const
+{
+    return(this->find(hName) != nullptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::nameEquals
+///////////////////////////////////////////////////////////////////////////////
+
+bool utility::headerList::nameEquals(const std::string& lhs, const std::string& rhs)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // field names are case-insensitive (RFC7230 [3.2])
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(lhs.size() != rhs.size())
+    {
+        return(false);
+    }
+    for(size_t index = 0; index < lhs.size(); index++)
+    {
+        char lChar{lhs[index]};
+        char rChar{rhs[index]};
+        if(lChar >= 'A' && lChar <= 'Z')
+        {
+            lChar |= 0x20;
+        }
+        if(rChar >= 'A' && rChar <= 'Z')
+        {
+            rChar |= 0x20;
+        }
+        if(lChar != rChar)
+        {
+            return(false);
+        }
+    }
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::remove
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::headerList::remove(const std::string& hName)
+{
+    this->removeFrom(0, hName);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::removeFrom
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::headerList::removeFrom(size_t startIndex, const std::string& hName)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // compact in place so insertion order of the remaining entries is kept
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t keepCount{startIndex};
+    for(size_t index = startIndex; index < this->entryCount; index++)
+    {
+        headerEntry& current{this->entryAt(index)};
+        if(utility::headerList::nameEquals(current.name, hName))
+        {
+            continue;
+        }
+        if(keepCount != index)
+        {
+            std::swap(this->entryAt(keepCount), current);
+        }
+        keepCount++;
+    }
+
+    if(this->entryCount > utility::headerList::inlineCapacity)
+    {
+        size_t overflowKeep{keepCount > utility::headerList::inlineCapacity ? keepCount - utility::headerList::inlineCapacity : 0};
+        this->overflowEntries.resize(overflowKeep);
+    }
+    for(size_t index = keepCount; index < this->entryCount && index < utility::headerList::inlineCapacity; index++)
+    {
+        this->inlineEntries[index].name.clear();
+        this->inlineEntries[index].value.clear();
+    }
+    this->entryCount = keepCount;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::serialize
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::headerList::serialize(std::string& target) const
+{
+    target.reserve(target.size() + this->serializedSize());
+    for(size_t index = 0; index < this->entryCount; index++)
+    {
+        const headerEntry& current{this->entryAt(index)};
+        target.append(current.name);
+        target.append(": ", 2);
+        target.append(current.value);
+        target.append("\r\n", 2);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::serialize
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::headerList::serialize(std::string& target, const std::vector<std::string>& skipNames) const
+{
+    target.reserve(target.size() + this->serializedSize());
+    for(size_t index = 0; index < this->entryCount; index++)
+    {
+        const headerEntry& current{this->entryAt(index)};
+        bool skipEntry{false};
+        for(const std::string& skipName : skipNames)
+        {
+            if(utility::headerList::nameEquals(current.name, skipName))
+            {
+                skipEntry = true;
+                break;
+            }
+        }
+        if(skipEntry)
+        {
+            continue;
+        }
+        target.append(current.name);
+        target.append(": ", 2);
+        target.append(current.value);
+        target.append("\r\n", 2);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::serializedSize
+///////////////////////////////////////////////////////////////////////////////
+
+size_t utility::headerList::serializedSize() const
+{
+    size_t totalSize{0};
+    for(size_t index = 0; index < this->entryCount; index++)
+    {
+        const headerEntry& current{this->entryAt(index)};
+        totalSize += current.name.size() + current.value.size() + 4;
+    }
+    return(totalSize);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::set
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::headerList::set(const std::string& hName, const std::string& hValue)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // replace the first entry with a matching name in place
+    // any later duplicates are dropped
+    ///////////////////////////////////////////////////////////////////////////////
+
+    for(size_t index = 0; index < this->entryCount; index++)
+    {
+        headerEntry& current{this->entryAt(index)};
+        if(utility::headerList::nameEquals(current.name, hName))
+        {
+            current.value.assign(hValue);
+            this->removeFrom(index + 1, hName);
+            return;
+        }
+    }
+    this->append(hName, hValue);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::headerList::size
+///////////////////////////////////////////////////////////////////////////////
+
+size_t utility::headerList::size() const
+{
+    return(this->entryCount);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+utility::headerList::~headerList()
+{
+
+}
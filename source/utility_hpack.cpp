@@ -0,0 +1,704 @@
+//
+// utility_hpack.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/utility_hpack.hpp"
+
+namespace utility = frederick2::utility;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// static table (RFC7541 Appendix A)
+///////////////////////////////////////////////////////////////////////////////
+
+static const std::pair<const char*, const char*> staticTable[]
+{
+    {":authority", ""},
+    {":method", "GET"},
+    {":method", "POST"},
+    {":path", "/"},
+    {":path", "/index.html"},
+    {":scheme", "http"},
+    {":scheme", "https"},
+    {":status", "200"},
+    {":status", "204"},
+    {":status", "206"},
+    {":status", "304"},
+    {":status", "400"},
+    {":status", "404"},
+    {":status", "500"},
+    {"accept-charset", ""},
+    {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""},
+    {"accept-ranges", ""},
+    {"accept", ""},
+    {"access-control-allow-origin", ""},
+    {"age", ""},
+    {"allow", ""},
+    {"authorization", ""},
+    {"cache-control", ""},
+    {"content-disposition", ""},
+    {"content-encoding", ""},
+    {"content-language", ""},
+    {"content-length", ""},
+    {"content-location", ""},
+    {"content-range", ""},
+    {"content-type", ""},
+    {"cookie", ""},
+    {"date", ""},
+    {"etag", ""},
+    {"expect", ""},
+    {"expires", ""},
+    {"from", ""},
+    {"host", ""},
+    {"if-match", ""},
+    {"if-modified-since", ""},
+    {"if-none-match", ""},
+    {"if-range", ""},
+    {"if-unmodified-since", ""},
+    {"last-modified", ""},
+    {"link", ""},
+    {"location", ""},
+    {"max-forwards", ""},
+    {"proxy-authenticate", ""},
+    {"proxy-authorization", ""},
+    {"range", ""},
+    {"referer", ""},
+    {"refresh", ""},
+    {"retry-after", ""},
+    {"server", ""},
+    {"set-cookie", ""},
+    {"strict-transport-security", ""},
+    {"transfer-encoding", ""},
+    {"user-agent", ""},
+    {"vary", ""},
+    {"via", ""},
+    {"www-authenticate", ""},
+};
+
+static const size_t staticTableSize{sizeof(staticTable) / sizeof(staticTable[0])};
+
+///////////////////////////////////////////////////////////////////////////////
+// huffman code and bit length per symbol, 256 is EOS (RFC7541 Appendix B)
+///////////////////////////////////////////////////////////////////////////////
+
+static const std::pair<uint32_t, uint8_t> huffmanCodes[]
+{
+    {0x1ff8, 13}, {0x7fffd8, 23}, {0xfffffe2, 28}, {0xfffffe3, 28},
+    {0xfffffe4, 28}, {0xfffffe5, 28}, {0xfffffe6, 28}, {0xfffffe7, 28},
+    {0xfffffe8, 28}, {0xffffea, 24}, {0x3ffffffc, 30}, {0xfffffe9, 28},
+    {0xfffffea, 28}, {0x3ffffffd, 30}, {0xfffffeb, 28}, {0xfffffec, 28},
+    {0xfffffed, 28}, {0xfffffee, 28}, {0xfffffef, 28}, {0xffffff0, 28},
+    {0xffffff1, 28}, {0xffffff2, 28}, {0x3ffffffe, 30}, {0xffffff3, 28},
+    {0xffffff4, 28}, {0xffffff5, 28}, {0xffffff6, 28}, {0xffffff7, 28},
+    {0xffffff8, 28}, {0xffffff9, 28}, {0xffffffa, 28}, {0xffffffb, 28},
+    {0x14, 6}, {0x3f8, 10}, {0x3f9, 10}, {0xffa, 12},
+    {0x1ff9, 13}, {0x15, 6}, {0xf8, 8}, {0x7fa, 11},
+    {0x3fa, 10}, {0x3fb, 10}, {0xf9, 8}, {0x7fb, 11},
+    {0xfa, 8}, {0x16, 6}, {0x17, 6}, {0x18, 6},
+    {0x0, 5}, {0x1, 5}, {0x2, 5}, {0x19, 6},
+    {0x1a, 6}, {0x1b, 6}, {0x1c, 6}, {0x1d, 6},
+    {0x1e, 6}, {0x1f, 6}, {0x5c, 7}, {0xfb, 8},
+    {0x7ffc, 15}, {0x20, 6}, {0xffb, 12}, {0x3fc, 10},
+    {0x1ffa, 13}, {0x21, 6}, {0x5d, 7}, {0x5e, 7},
+    {0x5f, 7}, {0x60, 7}, {0x61, 7}, {0x62, 7},
+    {0x63, 7}, {0x64, 7}, {0x65, 7}, {0x66, 7},
+    {0x67, 7}, {0x68, 7}, {0x69, 7}, {0x6a, 7},
+    {0x6b, 7}, {0x6c, 7}, {0x6d, 7}, {0x6e, 7},
+    {0x6f, 7}, {0x70, 7}, {0x71, 7}, {0x72, 7},
+    {0xfc, 8}, {0x73, 7}, {0xfd, 8}, {0x1ffb, 13},
+    {0x7fff0, 19}, {0x1ffc, 13}, {0x3ffc, 14}, {0x22, 6},
+    {0x7ffd, 15}, {0x3, 5}, {0x23, 6}, {0x4, 5},
+    {0x24, 6}, {0x5, 5}, {0x25, 6}, {0x26, 6},
+    {0x27, 6}, {0x6, 5}, {0x74, 7}, {0x75, 7},
+    {0x28, 6}, {0x29, 6}, {0x2a, 6}, {0x7, 5},
+    {0x2b, 6}, {0x76, 7}, {0x2c, 6}, {0x8, 5},
+    {0x9, 5}, {0x2d, 6}, {0x77, 7}, {0x78, 7},
+    {0x79, 7}, {0x7a, 7}, {0x7b, 7}, {0x7ffe, 15},
+    {0x7fc, 11}, {0x3ffd, 14}, {0x1ffd, 13}, {0xffffffc, 28},
+    {0xfffe6, 20}, {0x3fffd2, 22}, {0xfffe7, 20}, {0xfffe8, 20},
+    {0x3fffd3, 22}, {0x3fffd4, 22}, {0x3fffd5, 22}, {0x7fffd9, 23},
+    {0x3fffd6, 22}, {0x7fffda, 23}, {0x7fffdb, 23}, {0x7fffdc, 23},
+    {0x7fffdd, 23}, {0x7fffde, 23}, {0xffffeb, 24}, {0x7fffdf, 23},
+    {0xffffec, 24}, {0xffffed, 24}, {0x3fffd7, 22}, {0x7fffe0, 23},
+    {0xffffee, 24}, {0x7fffe1, 23}, {0x7fffe2, 23}, {0x7fffe3, 23},
+    {0x7fffe4, 23}, {0x1fffdc, 21}, {0x3fffd8, 22}, {0x7fffe5, 23},
+    {0x3fffd9, 22}, {0x7fffe6, 23}, {0x7fffe7, 23}, {0xffffef, 24},
+    {0x3fffda, 22}, {0x1fffdd, 21}, {0xfffe9, 20}, {0x3fffdb, 22},
+    {0x3fffdc, 22}, {0x7fffe8, 23}, {0x7fffe9, 23}, {0x1fffde, 21},
+    {0x7fffea, 23}, {0x3fffdd, 22}, {0x3fffde, 22}, {0xfffff0, 24},
+    {0x1fffdf, 21}, {0x3fffdf, 22}, {0x7fffeb, 23}, {0x7fffec, 23},
+    {0x1fffe0, 21}, {0x1fffe1, 21}, {0x3fffe0, 22}, {0x1fffe2, 21},
+    {0x7fffed, 23}, {0x3fffe1, 22}, {0x7fffee, 23}, {0x7fffef, 23},
+    {0xfffea, 20}, {0x3fffe2, 22}, {0x3fffe3, 22}, {0x3fffe4, 22},
+    {0x7ffff0, 23}, {0x3fffe5, 22}, {0x3fffe6, 22}, {0x7ffff1, 23},
+    {0x3ffffe0, 26}, {0x3ffffe1, 26}, {0xfffeb, 20}, {0x7fff1, 19},
+    {0x3fffe7, 22}, {0x7ffff2, 23}, {0x3fffe8, 22}, {0x1ffffec, 25},
+    {0x3ffffe2, 26}, {0x3ffffe3, 26}, {0x3ffffe4, 26}, {0x7ffffde, 27},
+    {0x7ffffdf, 27}, {0x3ffffe5, 26}, {0xfffff1, 24}, {0x1ffffed, 25},
+    {0x7fff2, 19}, {0x1fffe3, 21}, {0x3ffffe6, 26}, {0x7ffffe0, 27},
+    {0x7ffffe1, 27}, {0x3ffffe7, 26}, {0x7ffffe2, 27}, {0xfffff2, 24},
+    {0x1fffe4, 21}, {0x1fffe5, 21}, {0x3ffffe8, 26}, {0x3ffffe9, 26},
+    {0xffffffd, 28}, {0x7ffffe3, 27}, {0x7ffffe4, 27}, {0x7ffffe5, 27},
+    {0xfffec, 20}, {0xfffff3, 24}, {0xfffed, 20}, {0x1fffe6, 21},
+    {0x3fffe9, 22}, {0x1fffe7, 21}, {0x1fffe8, 21}, {0x7ffff3, 23},
+    {0x3fffea, 22}, {0x3fffeb, 22}, {0x1ffffee, 25}, {0x1ffffef, 25},
+    {0xfffff4, 24}, {0xfffff5, 24}, {0x3ffffea, 26}, {0x7ffff4, 23},
+    {0x3ffffeb, 26}, {0x7ffffe6, 27}, {0x3ffffec, 26}, {0x3ffffed, 26},
+    {0x7ffffe7, 27}, {0x7ffffe8, 27}, {0x7ffffe9, 27}, {0x7ffffea, 27},
+    {0x7ffffeb, 27}, {0xffffffe, 28}, {0x7ffffec, 27}, {0x7ffffed, 27},
+    {0x7ffffee, 27}, {0x7ffffef, 27}, {0x7fffff0, 27}, {0x3ffffee, 26},
+    {0x3fffffff, 30}
+};
+
+static const size_t defaultTableSize{4096};
+static const size_t maxHeaderListSize{65536};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::dynamicTable member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::dynamicTable::add
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::hpack::dynamicTable::add(const std::string& name, const std::string& value)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // entry size is name + value + 32 (RFC7541 [4.1])
+    // an entry larger than the table empties it and is not stored
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t entrySize{name.size() + value.size() + 32};
+    while(this->entries.size() > 0 && this->size + entrySize > this->maxSize)
+    {
+        this->size -= this->entries.back().first.size() + this->entries.back().second.size() + 32;
+        this->entries.pop_back();
+    }
+    if(entrySize <= this->maxSize)
+    {
+        this->entries.emplace_front(name, value);
+        this->size += entrySize;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::dynamicTable::resize
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::hpack::dynamicTable::resize(size_t newMax)
+{
+    this->maxSize = newMax;
+    while(this->entries.size() > 0 && this->size > this->maxSize)
+    {
+        this->size -= this->entries.back().first.size() + this->entries.back().second.size() + 32;
+        this->entries.pop_back();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack member definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// Constructor
+///////////////////////////////////////////////////////////////////////////////
+
+utility::hpack::hpack()
+{
+    this->encoderResized = false;
+    this->decoderTable.size = 0;
+    this->decoderTable.maxSize = defaultTableSize;
+    this->encoderTable.size = 0;
+    this->encoderTable.maxSize = defaultTableSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::decode
+///////////////////////////////////////////////////////////////////////////////
+
+bool utility::hpack::decode(const std::string& block, strPairVECTOR& fields)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // false on any malformed representation, which the caller must treat as
+    // a connection level COMPRESSION_ERROR since the table state is now unknown
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t pos{0};
+    size_t listSize{0};
+    bool fieldSeen{false};
+    while(pos < block.size())
+    {
+        unsigned char firstByte{static_cast<unsigned char>(block[pos])};
+        std::string name;
+        std::string value;
+        size_t index{0};
+
+        if(firstByte & 0x80)
+        {
+            ///////////////////////////////////////////////////////////////////////////////
+            // indexed field
+            ///////////////////////////////////////////////////////////////////////////////
+
+            if(!utility::hpack::decodeInteger(block, pos, 7, index) || index == 0)
+            {
+                return(false);
+            }
+            if(!this->lookup(index, name, value))
+            {
+                return(false);
+            }
+        }
+        else if((firstByte & 0xe0) == 0x20)
+        {
+            ///////////////////////////////////////////////////////////////////////////////
+            // dynamic table size update, only allowed ahead of the first field
+            ///////////////////////////////////////////////////////////////////////////////
+
+            if(fieldSeen || !utility::hpack::decodeInteger(block, pos, 5, index) || index > defaultTableSize)
+            {
+                return(false);
+            }
+            this->decoderTable.resize(index);
+            continue;
+        }
+        else
+        {
+            ///////////////////////////////////////////////////////////////////////////////
+            // literal field: incremental indexing (01), without indexing (0000)
+            // or never indexed (0001)
+            ///////////////////////////////////////////////////////////////////////////////
+
+            bool addToTable{(firstByte & 0xc0) == 0x40};
+            int prefixBits{addToTable ? 6 : 4};
+            if(!utility::hpack::decodeInteger(block, pos, prefixBits, index))
+            {
+                return(false);
+            }
+            if(index > 0)
+            {
+                std::string unusedValue;
+                if(!this->lookup(index, name, unusedValue))
+                {
+                    return(false);
+                }
+            }
+            else if(!utility::hpack::decodeString(block, pos, name))
+            {
+                return(false);
+            }
+            if(!utility::hpack::decodeString(block, pos, value))
+            {
+                return(false);
+            }
+            if(addToTable)
+            {
+                this->decoderTable.add(name, value);
+            }
+        }
+
+        fieldSeen = true;
+        listSize += name.size() + value.size() + 32;
+        if(listSize > maxHeaderListSize)
+        {
+            return(false);
+        }
+        fields.emplace_back(std::move(name), std::move(value));
+    }
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::decodeHuffman
+///////////////////////////////////////////////////////////////////////////////
+
+bool utility::hpack::decodeHuffman(const char *data, size_t length, std::string& decoded)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // walk the code tree bit by bit.  trailing padding must be shorter than
+    // a byte and made of the most significant bits of EOS, ie all ones
+    ///////////////////////////////////////////////////////////////////////////////
+
+    const std::vector<huffmanNode>& codeTree{utility::hpack::getHuffmanTree()};
+    int curNode{0};
+    int paddingBits{0};
+    bool paddingOnes{true};
+    for(size_t index = 0; index < length; index++)
+    {
+        unsigned char curByte{static_cast<unsigned char>(data[index])};
+        for(int bitIndex = 7; bitIndex >= 0; bitIndex--)
+        {
+            int curBit{(curByte >> bitIndex) & 1};
+            curNode = codeTree[curNode].child[curBit];
+            if(curNode < 0)
+            {
+                return(false);
+            }
+            paddingBits++;
+            paddingOnes &= curBit == 1;
+            if(codeTree[curNode].symbol >= 0)
+            {
+                if(codeTree[curNode].symbol == 256)
+                {
+                    return(false);
+                }
+                decoded.push_back(static_cast<char>(codeTree[curNode].symbol));
+                curNode = 0;
+                paddingBits = 0;
+                paddingOnes = true;
+            }
+        }
+    }
+    return(paddingBits < 8 && paddingOnes);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::decodeInteger
+///////////////////////////////////////////////////////////////////////////////
+
+bool utility::hpack::decodeInteger(const std::string& block, size_t& pos, int prefixBits, size_t& value)
+{
+    if(pos >= block.size())
+    {
+        return(false);
+    }
+    size_t prefixMax{(static_cast<size_t>(1) << prefixBits) - 1};
+    value = static_cast<unsigned char>(block[pos]) & prefixMax;
+    pos++;
+    if(value < prefixMax)
+    {
+        return(true);
+    }
+
+    int shift{0};
+    while(pos < block.size())
+    {
+        unsigned char curByte{static_cast<unsigned char>(block[pos])};
+        pos++;
+        if(shift > 28)
+        {
+            return(false);
+        }
+        value += static_cast<size_t>(curByte & 0x7f) << shift;
+        shift += 7;
+        if(!(curByte & 0x80))
+        {
+            return(true);
+        }
+    }
+    return(false);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::decodeString
+///////////////////////////////////////////////////////////////////////////////
+
+bool utility::hpack::decodeString(const std::string& block, size_t& pos, std::string& decoded)
+{
+    if(pos >= block.size())
+    {
+        return(false);
+    }
+    bool huffmanCoded{(static_cast<unsigned char>(block[pos]) & 0x80) != 0};
+    size_t length{0};
+    if(!utility::hpack::decodeInteger(block, pos, 7, length) || length > block.size() - pos)
+    {
+        return(false);
+    }
+
+    decoded.clear();
+    if(huffmanCoded)
+    {
+        if(!utility::hpack::decodeHuffman(block.data() + pos, length, decoded))
+        {
+            return(false);
+        }
+    }
+    else
+    {
+        decoded.assign(block, pos, length);
+    }
+    pos += length;
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::encode
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::hpack::encode(const strPairVECTOR& fields, std::string& block)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // exact table matches are sent as a single index.  everything else is a
+    // literal that is added to the dynamic table, except cookies which are
+    // never indexed so they cannot be probed through table state
+    ///////////////////////////////////////////////////////////////////////////////
+
+    if(this->encoderResized)
+    {
+        utility::hpack::encodeInteger(this->encoderTable.maxSize, 5, 0x20, block);
+        this->encoderResized = false;
+    }
+
+    for(const std::pair<std::string, std::string>& field : fields)
+    {
+        bool exactMatch{false};
+        size_t index{this->findField(field.first, field.second, exactMatch)};
+        if(exactMatch)
+        {
+            utility::hpack::encodeInteger(index, 7, 0x80, block);
+            continue;
+        }
+
+        bool sensitive{field.first == "set-cookie" || field.first == "cookie"};
+        if(sensitive)
+        {
+            utility::hpack::encodeInteger(index, 4, 0x10, block);
+        }
+        else
+        {
+            utility::hpack::encodeInteger(index, 6, 0x40, block);
+        }
+        if(index == 0)
+        {
+            utility::hpack::encodeString(field.first, block);
+        }
+        utility::hpack::encodeString(field.second, block);
+        if(!sensitive)
+        {
+            this->encoderTable.add(field.first, field.second);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::encodeHuffman
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::hpack::encodeHuffman(const std::string& original, std::string& encoded)
+{
+    uint64_t bitBuffer{0};
+    int bitCount{0};
+    for(char curChar : original)
+    {
+        const std::pair<uint32_t, uint8_t>& code{huffmanCodes[static_cast<unsigned char>(curChar)]};
+        bitBuffer = (bitBuffer << code.second) | code.first;
+        bitCount += code.second;
+        while(bitCount >= 8)
+        {
+            bitCount -= 8;
+            encoded.push_back(static_cast<char>((bitBuffer >> bitCount) & 0xff));
+        }
+    }
+    if(bitCount > 0)
+    {
+        bitBuffer = (bitBuffer << (8 - bitCount)) | ((1 << (8 - bitCount)) - 1);
+        encoded.push_back(static_cast<char>(bitBuffer & 0xff));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::encodeInteger
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::hpack::encodeInteger(size_t value, int prefixBits, unsigned char firstByte, std::string& block)
+{
+    size_t prefixMax{(static_cast<size_t>(1) << prefixBits) - 1};
+    if(value < prefixMax)
+    {
+        block.push_back(static_cast<char>(firstByte | value));
+        return;
+    }
+    block.push_back(static_cast<char>(firstByte | prefixMax));
+    value -= prefixMax;
+    while(value >= 0x80)
+    {
+        block.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    block.push_back(static_cast<char>(value));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::encodeString
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::hpack::encodeString(const std::string& original, std::string& block)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // huffman only when it actually saves space
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t bitLength{0};
+    for(char curChar : original)
+    {
+        bitLength += huffmanCodes[static_cast<unsigned char>(curChar)].second;
+    }
+    size_t huffmanLength{(bitLength + 7) / 8};
+    if(huffmanLength < original.size())
+    {
+        utility::hpack::encodeInteger(huffmanLength, 7, 0x80, block);
+        utility::hpack::encodeHuffman(original, block);
+    }
+    else
+    {
+        utility::hpack::encodeInteger(original.size(), 7, 0x00, block);
+        block.append(original);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::findField
+///////////////////////////////////////////////////////////////////////////////
+
+size_t utility::hpack::findField(const std::string& name, const std::string& value, bool& exactMatch)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // returns the best index for name (0 if unknown), exactMatch when the
+    // value matched as well
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t nameIndex{0};
+    exactMatch = false;
+    for(size_t index = 0; index < staticTableSize; index++)
+    {
+        if(name == staticTable[index].first)
+        {
+            if(value == staticTable[index].second)
+            {
+                exactMatch = true;
+                return(index + 1);
+            }
+            if(nameIndex == 0)
+            {
+                nameIndex = index + 1;
+            }
+        }
+    }
+    for(size_t index = 0; index < this->encoderTable.entries.size(); index++)
+    {
+        const std::pair<std::string, std::string>& entry{this->encoderTable.entries[index]};
+        if(entry.first == name)
+        {
+            if(entry.second == value)
+            {
+                exactMatch = true;
+                return(staticTableSize + index + 1);
+            }
+            if(nameIndex == 0)
+            {
+                nameIndex = staticTableSize + index + 1;
+            }
+        }
+    }
+    return(nameIndex);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::getHuffmanTree
+///////////////////////////////////////////////////////////////////////////////
+
+const std::vector<utility::hpack::huffmanNode>& utility::hpack::getHuffmanTree()
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // binary decode tree built once from the code table
+    ///////////////////////////////////////////////////////////////////////////////
+
+    static const std::vector<huffmanNode> codeTree{[]
+    {
+        std::vector<huffmanNode> newTree;
+        newTree.push_back(huffmanNode{{-1, -1}, -1});
+        for(int symbol = 0; symbol <= 256; symbol++)
+        {
+            uint32_t code{huffmanCodes[symbol].first};
+            int length{huffmanCodes[symbol].second};
+            int curNode{0};
+            for(int bitIndex = length - 1; bitIndex >= 0; bitIndex--)
+            {
+                int curBit{static_cast<int>((code >> bitIndex) & 1)};
+                if(newTree[curNode].child[curBit] < 0)
+                {
+                    newTree[curNode].child[curBit] = newTree.size();
+                    newTree.push_back(huffmanNode{{-1, -1}, -1});
+                }
+                curNode = newTree[curNode].child[curBit];
+            }
+            newTree[curNode].symbol = symbol;
+        }
+        return(newTree);
+    }()};
+    return(codeTree);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::lookup
+///////////////////////////////////////////////////////////////////////////////
+
+bool utility::hpack::lookup(size_t index, std::string& name, std::string& value)
+{
+    if(index == 0)
+    {
+        return(false);
+    }
+    if(index <= staticTableSize)
+    {
+        name = staticTable[index - 1].first;
+        value = staticTable[index - 1].second;
+        return(true);
+    }
+    index -= staticTableSize + 1;
+    if(index >= this->decoderTable.entries.size())
+    {
+        return(false);
+    }
+    name = this->decoderTable.entries[index].first;
+    value = this->decoderTable.entries[index].second;
+    return(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::hpack::setEncoderLimit
+///////////////////////////////////////////////////////////////////////////////
+
+void utility::hpack::setEncoderLimit(size_t peerLimit)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // peer's SETTINGS_HEADER_TABLE_SIZE caps our encoder table.  the change
+    // is announced at the start of the next header block
+    ///////////////////////////////////////////////////////////////////////////////
+
+    size_t newMax{peerLimit < defaultTableSize ? peerLimit : defaultTableSize};
+    if(newMax != this->encoderTable.maxSize)
+    {
+        this->encoderTable.resize(newMax);
+        this->encoderResized = true;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deconstructor
+///////////////////////////////////////////////////////////////////////////////
+
+utility::hpack::~hpack()
+{
+
+}
@@ -8,9 +8,12 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
 #include <exception>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include "../headers/frederick2_namespace.hpp"
 #include "../headers/utility_parse.hpp"
@@ -37,6 +40,40 @@ utility::parseUtilities::parseUtilities()
     
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::utility::parseUtilities::decodeSegment
+///////////////////////////////////////////////////////////////////////////////
+
+bool utility::parseUtilities::decodeSegment(std::string_view original, std::string& revised)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // single pass pctDecode + toLower for one raw path segment
+    ///////////////////////////////////////////////////////////////////////////////
+
+    revised.clear();
+    revised.reserve(original.size());
+    for(size_t i = 0; i < original.size(); i++)
+    {
+        char c0{original[i]};
+        if(c0 == '+')
+        {
+            c0 = ' ';
+        }
+        else if(c0 == '%')
+        {
+            if(i + 2 >= original.size() || !this->isHex(original[i+1]) || !this->isHex(original[i+2]))
+            {
+                return(false);
+            }
+            char hexChars[3]{original[i+1], original[i+2], '\0'};
+            c0 = static_cast<char>(std::strtoul(hexChars, nullptr, 16));
+            i += 2;
+        }
+        revised.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c0))));
+    }
+    return(true);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // frederick2::utility::parseUtilities::dqExtract
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,180 @@
+//
+// alloc_count.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Author: Joseph Adomatis
+// Copyright (c) 2020 Joseph R Adomatis (joseph dot adomatis at gmail dot com)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "../headers/frederick2_namespace.hpp"
+#include "../headers/http_request.hpp"
+#include "../headers/http_response.hpp"
+#include "../headers/server.hpp"
+#include "../headers/server_enum.hpp"
+#include "../headers/server_resource.hpp"
+
+namespace enums = frederick2::httpEnums;
+namespace packet = frederick2::httpPacket;
+namespace server = frederick2::httpServer;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global variable definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// budgets are heap allocations per request once pools are warm, covering
+// parse, routing, the handler and serializing the response
+///////////////////////////////////////////////////////////////////////////////
+
+static const size_t getBudget{3};
+static const size_t postBudget{5};
+static const size_t warmRounds{64};
+static const size_t countRounds{1024};
+
+static std::atomic<size_t> allocCount{0};
+static std::atomic<bool> allocCounting{false};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// global function definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void* operator new(size_t allocSize)
+{
+    if(allocCounting.load(std::memory_order_relaxed))
+    {
+        allocCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    void *allocPtr{std::malloc(allocSize > 0 ? allocSize : 1)};
+    if(allocPtr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return(allocPtr);
+}
+
+void operator delete(void *allocPtr) noexcept
+{
+    std::free(allocPtr);
+}
+
+void operator delete(void *allocPtr, size_t) noexcept
+{
+    std::free(allocPtr);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::testHarness
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class frederick2::httpServer::testHarness
+{
+public:
+    static size_t countRequest(server::httpServer*, const std::string&, enums::httpStatus&);
+    static void runRequest(server::httpServer*, std::string&, std::string&, enums::httpStatus&);
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::testHarness::countRequest
+///////////////////////////////////////////////////////////////////////////////
+
+size_t server::testHarness::countRequest(server::httpServer *testServer, const std::string& rawRequest, enums::httpStatus& lastStatus)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // wire and outString stand in for a keep-alive connection's receive
+    // buffer and send string; they are sized before counting starts
+    ///////////////////////////////////////////////////////////////////////////////
+
+    std::string wire;
+    std::string outString;
+    wire.reserve(rawRequest.size() * 2);
+    for(size_t round = 0; round < warmRounds; round++)
+    {
+        wire.assign(rawRequest);
+        server::testHarness::runRequest(testServer, wire, outString, lastStatus);
+    }
+
+    allocCount = 0;
+    allocCounting = true;
+    for(size_t round = 0; round < countRounds; round++)
+    {
+        wire.assign(rawRequest);
+        server::testHarness::runRequest(testServer, wire, outString, lastStatus);
+    }
+    allocCounting = false;
+    return((allocCount.load() + countRounds - 1) / countRounds);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// frederick2::httpServer::testHarness::runRequest
+///////////////////////////////////////////////////////////////////////////////
+
+void server::testHarness::runRequest(server::httpServer *testServer, std::string& wire, std::string& outString, enums::httpStatus& lastStatus)
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // the same steps connection::handleConnection takes for a request
+    // that arrived whole
+    ///////////////////////////////////////////////////////////////////////////////
+
+    packet::httpRequest *request{testServer->acquireRequest(&wire)};
+    request->memory = testServer->memory;
+    request->buildRequest();
+    packet::httpResponse *response{testServer->handleRequest(request, true)};
+    lastStatus = response->getStatus();
+    outString = response->toString();
+    testServer->releaseResponse(response);
+    testServer->releaseRequest(request);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// main
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main()
+{
+    server::httpServer *testServer{new server::httpServer()};
+    testServer->updateRoutes([](server::resource *treeRoot){
+        server::resource *itemResource{treeRoot->addChild("items", enums::resourceType::STATIC)};
+        itemResource->addHandler(enums::httpMethod::GET, [](packet::httpRequest*, packet::httpResponse *response){
+            response->setContent("item list");
+            response->addHeader("Content-Type", "text/plain");
+            response->setStatus(enums::httpStatus::OK);
+        });
+        itemResource->addHandler(enums::httpMethod::POST, [](packet::httpRequest *request, packet::httpResponse *response){
+            response->setContent(request->getContentView().size() > 0 ? "stored" : "empty");
+            response->addHeader("Content-Type", "text/plain");
+            response->setStatus(enums::httpStatus::CREATED);
+        });
+    });
+
+    std::string rawGet{"GET /items HTTP/1.1\r\nHost: 127.0.0.1\r\nUser-Agent: alloc_count\r\nAccept: */*\r\n\r\n"};
+    std::string rawPost{"POST /items HTTP/1.1\r\nHost: 127.0.0.1\r\nUser-Agent: alloc_count\r\nContent-Type: application/json\r\nContent-Length: 27\r\n\r\n{\"name\":\"frederick\",\"id\":2}"};
+
+    enums::httpStatus getStatus{enums::httpStatus::ENUMERROR};
+    enums::httpStatus postStatus{enums::httpStatus::ENUMERROR};
+    size_t getAllocs{server::testHarness::countRequest(testServer, rawGet, getStatus)};
+    size_t postAllocs{server::testHarness::countRequest(testServer, rawPost, postStatus)};
+    delete testServer;
+
+    std::printf("GET  %zu allocations per request (budget %zu)\n", getAllocs, getBudget);
+    std::printf("POST %zu allocations per request (budget %zu)\n", postAllocs, postBudget);
+
+    bool testPassed{true};
+    if(getStatus != enums::httpStatus::OK || postStatus != enums::httpStatus::CREATED)
+    {
+        std::printf("unexpected status: GET %d, POST %d\n", static_cast<int>(getStatus), static_cast<int>(postStatus));
+        testPassed = false;
+    }
+    if(getAllocs > getBudget || postAllocs > postBudget)
+    {
+        std::printf("allocation budget exceeded\n");
+        testPassed = false;
+    }
+    return(testPassed ? 0 : 1);
+}